@@ -32,9 +32,12 @@ public class KantanDocGen : ModuleRules
 				"MainFrame",
 				"LevelEditor",
 				"XmlParser",
+				"Json",
 				"UMG",
 				"Projects",
-                "ImageWriteQueue"
+                "ImageWriteQueue",
+                "ImageWrapper",
+                "TraceLog"
             }
         );
 	}
@@ -0,0 +1,322 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenBenchmark.h"
+#include "KantanDocGenLog.h"
+#include "DocGenModel.h"
+#include "Output/DocGenXmlWriter.h"
+#include "Output/DocGenIntermediateFormat.h"
+#include "XmlFile.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+
+namespace DocGenBenchmark
+{
+	namespace
+	{
+		class FCountingMalloc : public FMalloc
+		{
+		public:
+			FMalloc* Inner = nullptr;
+			uint32 ThreadId = 0;
+			int64 NumAllocs = 0;
+			int64 AllocatedBytes = 0;
+
+			void Record(SIZE_T Size)
+			{
+				// Only the owning thread ever writes the counters
+				if(FPlatformTLS::GetCurrentThreadId() == ThreadId)
+				{
+					++NumAllocs;
+					AllocatedBytes += Size;
+				}
+			}
+
+			virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+			{
+				Record(Count);
+				return Inner->Malloc(Count, Alignment);
+			}
+
+			virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+			{
+				if(Count > 0)
+				{
+					Record(Count);
+				}
+				return Inner->Realloc(Original, Count, Alignment);
+			}
+
+			virtual void Free(void* Original) override { Inner->Free(Original); }
+			virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+			virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+			virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+			virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+			virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+			virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+			virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+			virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+			virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+			virtual void UpdateStats() override { Inner->UpdateStats(); }
+			virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+		};
+
+		// Never destroyed, since another thread may still be inside a call when the counter is removed
+		FCountingMalloc* CountingMalloc = nullptr;
+
+
+		FDocGenNodeEntry MakeSyntheticNode(int32 Index)
+		{
+			auto MakeParam = [](int32 ParamIdx)
+			{
+				FDocGenParamEntry Param;
+				Param.Name = FString::Printf(TEXT("Parameter %i"), ParamIdx);
+				Param.Type = TEXT("Array of Object References");
+				Param.Description = TEXT("Description of the parameter, long enough to be representative of a typical tooltip.\nWith a second line.");
+				return Param;
+			};
+
+			FDocGenNodeEntry Node;
+			Node.Id = FString::Printf(TEXT("SyntheticFunction_%i"), Index);
+			Node.ShortTitle = FString::Printf(TEXT("Synthetic Function %i"), Index);
+			Node.FullTitle = Node.ShortTitle;
+			Node.Description = TEXT("Synthetic node used for benchmarking. The description contains a CDATA terminator ]]> to exercise escaping.");
+			Node.ImagePath = TEXT("../../img/0123456789abcdef.png");
+			Node.Category = TEXT("Benchmark|Synthetic");
+			for(int32 Idx = 0; Idx < 4; ++Idx)
+			{
+				Node.Inputs.Add(MakeParam(Idx));
+			}
+			for(int32 Idx = 0; Idx < 2; ++Idx)
+			{
+				Node.Outputs.Add(MakeParam(Idx));
+			}
+			return Node;
+		}
+
+		// Mirrors the DOM construction previously used for node documents
+		bool SaveNodeDom(FDocGenNodeEntry const& Node, FString const& Path)
+		{
+			auto WrapAsCDATA = [](FString const& InString)
+			{
+				return TEXT("<![CDATA[") + InString.Replace(TEXT("]]>"), TEXT("]]]]><![CDATA[>")) + TEXT("]]>");
+			};
+
+			auto AppendChild = [](FXmlNode* Parent, FString const& Name)
+			{
+				Parent->AppendChildNode(Name, FString());
+				return Parent->GetChildrenNodes().Last();
+			};
+
+			auto AppendChildCDATA = [&](FXmlNode* Parent, FString const& Name, FString const& TextContent)
+			{
+				Parent->AppendChildNode(Name, WrapAsCDATA(TextContent));
+				return Parent->GetChildrenNodes().Last();
+			};
+
+			const FString FileTemplate = R"xxx(<?xml version="1.0" encoding="UTF-8"?>
+<root></root>)xxx";
+
+			FXmlFile File(FileTemplate, EConstructMethod::ConstructFromBuffer);
+			auto Root = File.GetRootNode();
+
+			AppendChildCDATA(Root, TEXT("docs_name"), TEXT("Benchmark"));
+			AppendChildCDATA(Root, TEXT("class_id"), TEXT("BenchmarkClass"));
+			AppendChildCDATA(Root, TEXT("class_name"), TEXT("Benchmark Class"));
+			AppendChildCDATA(Root, TEXT("shorttitle"), Node.ShortTitle);
+			AppendChildCDATA(Root, TEXT("fulltitle"), Node.FullTitle);
+			AppendChildCDATA(Root, TEXT("description"), Node.Description);
+			AppendChildCDATA(Root, TEXT("imgpath"), Node.ImagePath);
+			AppendChildCDATA(Root, TEXT("category"), Node.Category);
+
+			auto AppendParams = [&](TCHAR const* Name, TArray< FDocGenParamEntry > const& Params)
+			{
+				auto Container = AppendChild(Root, Name);
+				for(auto const& Param : Params)
+				{
+					auto ParamElem = AppendChild(Container, TEXT("param"));
+					AppendChildCDATA(ParamElem, TEXT("name"), Param.Name);
+					AppendChildCDATA(ParamElem, TEXT("type"), Param.Type);
+					AppendChildCDATA(ParamElem, TEXT("description"), Param.Description);
+				}
+			};
+			AppendParams(TEXT("inputs"), Node.Inputs);
+			AppendParams(TEXT("outputs"), Node.Outputs);
+
+			return File.Save(Path);
+		}
+
+		bool SaveNodeStreamed(FDocGenXmlWriter& Writer, FDocGenNodeEntry const& Node, FString const& Path)
+		{
+			static FDocGenClassEntry const ClassDoc{ TEXT("BenchmarkClass"), TEXT("Benchmark Class") };
+
+			DocGenIntermediate::WriteNode(Writer, TEXT("Benchmark"), ClassDoc, Node);
+			return Writer.SaveToFile(Path);
+		}
+
+		FString GetScratchDir()
+		{
+			return FPaths::ProjectIntermediateDir() / TEXT("KantanDocGen") / TEXT("Benchmark");
+		}
+	}
+
+
+	FScopedAllocationCounter::FScopedAllocationCounter()
+	{
+		if(CountingMalloc == nullptr)
+		{
+			CountingMalloc = new FCountingMalloc();
+		}
+
+		check(GMalloc != CountingMalloc);
+		CountingMalloc->Inner = GMalloc;
+		CountingMalloc->ThreadId = FPlatformTLS::GetCurrentThreadId();
+		CountingMalloc->NumAllocs = 0;
+		CountingMalloc->AllocatedBytes = 0;
+		FPlatformMisc::MemoryBarrier();
+
+		GMalloc = CountingMalloc;
+
+		// Make sure allocations really reach the wrapper here, rather than silently under-counting
+		FMemory::Free(FMemory::Malloc(16));
+		bCounting = CountingMalloc->NumAllocs > 0;
+		CountingMalloc->NumAllocs = 0;
+		CountingMalloc->AllocatedBytes = 0;
+	}
+
+	FScopedAllocationCounter::~FScopedAllocationCounter()
+	{
+		GMalloc = CountingMalloc->Inner;
+		FPlatformMisc::MemoryBarrier();
+	}
+
+	int64 FScopedAllocationCounter::GetNumAllocs() const
+	{
+		return bCounting ? CountingMalloc->NumAllocs : -1;
+	}
+
+	int64 FScopedAllocationCounter::GetAllocatedBytes() const
+	{
+		return bCounting ? CountingMalloc->AllocatedBytes : -1;
+	}
+
+	FString FormatResult(FResult const& Result)
+	{
+		FString const Allocs = Result.NumAllocs < 0 ? FString(TEXT("allocations not counted")) : FString::Printf(TEXT("%.1f allocs/op, %.0f allocated bytes/op"),
+			Result.NumOps > 0 ? (double)Result.NumAllocs / Result.NumOps : 0.0,
+			Result.NumOps > 0 ? (double)Result.AllocatedBytes / Result.NumOps : 0.0
+		);
+
+		return FString::Printf(TEXT("%s: %i ops in %.3fs (%.0f ops/s), %s, %.0f output bytes/op%s"),
+			*Result.Name,
+			Result.NumOps,
+			Result.Seconds,
+			Result.GetOpsPerSecond(),
+			*Allocs,
+			Result.NumOps > 0 ? (double)Result.OutputBytes / Result.NumOps : 0.0,
+			Result.bSucceeded ? TEXT("") : TEXT(", FAILED")
+		);
+	}
+
+	void LogResult(FResult const& Result)
+	{
+		UE_LOG(LogKantanDocGen, Display, TEXT("[Benchmark] %s"), *FormatResult(Result));
+	}
+
+	TArray< FString > GetXmlBenchmarkNames()
+	{
+		return { TEXT("NodeXml.Dom"), TEXT("NodeXml.Streamed") };
+	}
+
+	TArray< FResult > RunXmlBenchmarks(int32 NumDocs, FString const& OnlyName)
+	{
+		auto ShouldRun = [&OnlyName](TCHAR const* Name)
+		{
+			return OnlyName.IsEmpty() || OnlyName == Name;
+		};
+
+		TArray< FDocGenNodeEntry > Nodes;
+		Nodes.Reserve(NumDocs);
+		for(int32 Idx = 0; Idx < NumDocs; ++Idx)
+		{
+			Nodes.Add(MakeSyntheticNode(Idx));
+		}
+
+		auto const ScratchDir = GetScratchDir();
+		IFileManager::Get().DeleteDirectory(*ScratchDir, false, true);
+		IFileManager::Get().MakeDirectory(*ScratchDir, true);
+
+		auto GetPath = [&ScratchDir](int32 Idx)
+		{
+			// Alternate between a small set of files so the file system cost stays comparable between runs
+			return ScratchDir / FString::Printf(TEXT("node_%i.xml"), Idx % 16);
+		};
+
+		auto TotalFileSize = [&]()
+		{
+			int64 Total = 0;
+			for(int32 Idx = 0; Idx < FMath::Min(NumDocs, 16); ++Idx)
+			{
+				Total += IFileManager::Get().FileSize(*GetPath(Idx));
+			}
+			return Total;
+		};
+
+		TArray< FResult > Results;
+
+		if(ShouldRun(TEXT("NodeXml.Dom")))
+		{
+			FResult Result;
+			Result.Name = TEXT("NodeXml.Dom");
+			Result.NumOps = NumDocs;
+
+			double const StartTime = FPlatformTime::Seconds();
+			{
+				FScopedAllocationCounter Allocs;
+				for(int32 Idx = 0; Idx < NumDocs; ++Idx)
+				{
+					Result.bSucceeded &= SaveNodeDom(Nodes[Idx], GetPath(Idx));
+				}
+				Result.NumAllocs = Allocs.GetNumAllocs();
+				Result.AllocatedBytes = Allocs.GetAllocatedBytes();
+			}
+			Result.Seconds = FPlatformTime::Seconds() - StartTime;
+			Result.OutputBytes = NumDocs > 0 ? TotalFileSize() * NumDocs / FMath::Min(NumDocs, 16) : 0;
+
+			Results.Add(Result);
+		}
+
+		if(ShouldRun(TEXT("NodeXml.Streamed")))
+		{
+			FResult Result;
+			Result.Name = TEXT("NodeXml.Streamed");
+			Result.NumOps = NumDocs;
+
+			FDocGenXmlWriter Writer;
+			double const StartTime = FPlatformTime::Seconds();
+			{
+				FScopedAllocationCounter Allocs;
+				for(int32 Idx = 0; Idx < NumDocs; ++Idx)
+				{
+					Result.bSucceeded &= SaveNodeStreamed(Writer, Nodes[Idx], GetPath(Idx));
+				}
+				Result.NumAllocs = Allocs.GetNumAllocs();
+				Result.AllocatedBytes = Allocs.GetAllocatedBytes();
+			}
+			Result.Seconds = FPlatformTime::Seconds() - StartTime;
+			Result.OutputBytes = Writer.GetBytesSaved();
+
+			Results.Add(Result);
+		}
+
+		IFileManager::Get().DeleteDirectory(*ScratchDir, false, true);
+		return Results;
+	}
+}
@@ -0,0 +1,117 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+struct FKantanDocGenSettings;
+struct FDocGenTaskResult;
+
+/*
+Micro benchmarks for the hot paths of doc generation.
+Each measurement is an automation test under KantanDocGen.Benchmark, so runs with the automation framework
+(-ExecCmds="Automation RunTests KantanDocGen"), and the console commands and the commandlet's -Benchmark switch run those tests.
+Scaling benchmarks over a synthetic project run the whole pipeline, so only through the commandlet (-ScalingBenchmark).
+*/
+namespace DocGenBenchmark
+{
+	struct FResult
+	{
+		FString Name;
+		int32 NumOps = 0;
+		double Seconds = 0.0;
+		int64 NumAllocs = -1;			// Heap allocations made by the benchmarking thread, -1 if they couldn't be counted
+		int64 AllocatedBytes = -1;
+		int64 OutputBytes = 0;
+		bool bSucceeded = true;
+
+		double GetOpsPerSecond() const { return Seconds > 0.0 ? NumOps / Seconds : 0.0; }
+	};
+
+	/*
+	Counts heap allocations made by the constructing thread while in scope, with a counting GMalloc wrapper that is
+	installed only for the scope. Other threads pass straight through it uncounted. Only one may be active at a time.
+	*/
+	class FScopedAllocationCounter
+	{
+	public:
+		FScopedAllocationCounter();
+		~FScopedAllocationCounter();
+
+		/** False if allocations don't go through GMalloc on this platform, in which case the counts are -1 */
+		bool IsCounting() const { return bCounting; }
+
+		int64 GetNumAllocs() const;
+		int64 GetAllocatedBytes() const;
+
+	private:
+		bool bCounting;
+	};
+
+	FString FormatResult(FResult const& Result);
+	void LogResult(FResult const& Result);
+
+	/** Names of the measurements made by RunXmlBenchmarks */
+	TArray< FString > GetXmlBenchmarkNames();
+
+	/**
+	Writes NumDocs synthetic node documents with the old DOM approach and with the streaming writer.
+	If OnlyName is given, just that measurement is made.
+	*/
+	TArray< FResult > RunXmlBenchmarks(int32 NumDocs, FString const& OnlyName = FString());
+
+	/** Names of the measurements made by RunPipelineBenchmarks */
+	TArray< FString > GetPipelineBenchmarkNames();
+
+	/**
+	Enumerator prepasses, spawner filtering, pin tooltip parsing and node doc generation, run against fixed engine modules.
+	If OnlyName is given, just that measurement is made. Game thread only.
+	*/
+	TArray< FResult > RunPipelineBenchmarks(int32 NumIterations, FString const& OnlyName = FString());
+
+	/** Runs the benchmark automation tests whose path starts with TestPath, returning false if any failed or none were found */
+	bool RunBenchmarkTests(FString const& TestPath);
+
+	/** Console command entry point, args are [NumDocs] */
+	void ExecXmlBenchmarks(TArray< FString > const& Args);
+
+	/** Console command entry point, args are [NumIterations] */
+	void ExecPipelineBenchmarks(TArray< FString > const& Args);
+
+	/** Shape of the synthetic project generated for scaling benchmarks */
+	struct FSyntheticProjectSpec
+	{
+		int32 NumClasses = 100;
+		int32 NumFunctionsPerClass = 20;
+		int32 NumPinsPerFunction = 4;
+		int32 TooltipLength = 200;		// Characters of function tooltip, before the @param lines
+	};
+
+	struct FScalingResult
+	{
+		FSyntheticProjectSpec Spec;
+		bool bSucceeded = false;
+		int32 NumNodes = 0;
+		double CreateSeconds = 0.0;		// Generating and compiling the blueprints, not included in Seconds
+		double Seconds = 0.0;
+		int64 PeakMemoryBytes = 0;		// Peak process memory above that in use before the blueprints were created
+	};
+
+	/**
+	For each class count, generates that many blueprints in unsaved /Temp packages, documents them with the full task pipeline,
+	and records wall time and peak memory. Results are logged and written to ScalingBenchmark.json in the output directory.
+	RunTask must run the task to completion, pumping the game thread and core ticker meanwhile. Game thread only.
+	*/
+	TArray< FScalingResult > RunScalingBenchmarks(
+		FKantanDocGenSettings const& BaseSettings,
+		FSyntheticProjectSpec const& Spec,
+		TArray< int32 > const& ClassCounts,
+		TFunctionRef< FDocGenTaskResult(FKantanDocGenSettings const&) > RunTask);
+}
+
+
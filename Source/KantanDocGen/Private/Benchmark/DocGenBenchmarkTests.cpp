@@ -0,0 +1,159 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenBenchmark.h"
+#include "KantanDocGenLog.h"
+#include "Misc/AutomationTest.h"
+#include "HAL/IConsoleManager.h"
+
+
+namespace DocGenBenchmark
+{
+	namespace
+	{
+		TAutoConsoleVariable< int32 > CVarXmlBenchmarkDocs(
+			TEXT("KantanDocGen.Benchmark.XmlDocs"),
+			2000,
+			TEXT("Number of node documents written by each xml benchmark test.")
+		);
+
+		TAutoConsoleVariable< int32 > CVarPipelineBenchmarkIterations(
+			TEXT("KantanDocGen.Benchmark.PipelineIterations"),
+			5,
+			TEXT("Number of iterations made by each pipeline benchmark test.")
+		);
+
+		// Positive first argument overrides the size used by the tests
+		void SetSizeFromArgs(TAutoConsoleVariable< int32 >& CVar, TArray< FString > const& Args)
+		{
+			int32 const Size = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 0;
+			if(Size > 0)
+			{
+				CVar->Set(Size, ECVF_SetByConsole);
+			}
+		}
+
+#if WITH_DEV_AUTOMATION_TESTS
+		void GetBenchmarkTests(TArray< FString > const& Names, TArray< FString >& OutBeautifiedNames, TArray< FString >& OutTestCommands)
+		{
+			for(auto const& Name : Names)
+			{
+				OutBeautifiedNames.Add(Name);
+				OutTestCommands.Add(Name);
+			}
+		}
+
+		bool ReportResult(FAutomationTestBase& Test, FString const& Name, TArray< FResult > const& Results)
+		{
+			auto Result = Results.FindByPredicate([&Name](FResult const& Entry) { return Entry.Name == Name; });
+			if(Result == nullptr)
+			{
+				Test.AddError(FString::Printf(TEXT("Benchmark '%s' did not run."), *Name));
+				return false;
+			}
+
+			LogResult(*Result);
+			Test.AddInfo(FormatResult(*Result));
+
+			if(!Result->bSucceeded || Result->NumOps == 0)
+			{
+				Test.AddError(FString::Printf(TEXT("Benchmark '%s' failed."), *Name));
+				return false;
+			}
+			return true;
+		}
+#endif
+	}
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+	IMPLEMENT_COMPLEX_AUTOMATION_TEST(FDocGenXmlBenchmarkTest, "KantanDocGen.Benchmark.Xml", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::PerfFilter)
+
+	void FDocGenXmlBenchmarkTest::GetTests(TArray< FString >& OutBeautifiedNames, TArray< FString >& OutTestCommands) const
+	{
+		GetBenchmarkTests(GetXmlBenchmarkNames(), OutBeautifiedNames, OutTestCommands);
+	}
+
+	bool FDocGenXmlBenchmarkTest::RunTest(FString const& Parameters)
+	{
+		return ReportResult(*this, Parameters, RunXmlBenchmarks(CVarXmlBenchmarkDocs.GetValueOnGameThread(), Parameters));
+	}
+
+	IMPLEMENT_COMPLEX_AUTOMATION_TEST(FDocGenPipelineBenchmarkTest, "KantanDocGen.Benchmark.Pipeline", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::PerfFilter)
+
+	void FDocGenPipelineBenchmarkTest::GetTests(TArray< FString >& OutBeautifiedNames, TArray< FString >& OutTestCommands) const
+	{
+		GetBenchmarkTests(GetPipelineBenchmarkNames(), OutBeautifiedNames, OutTestCommands);
+	}
+
+	bool FDocGenPipelineBenchmarkTest::RunTest(FString const& Parameters)
+	{
+		return ReportResult(*this, Parameters, RunPipelineBenchmarks(CVarPipelineBenchmarkIterations.GetValueOnGameThread(), Parameters));
+	}
+#endif
+
+
+	bool RunBenchmarkTests(FString const& TestPath)
+	{
+#if WITH_DEV_AUTOMATION_TESTS
+		auto& Framework = FAutomationTestFramework::Get();
+		Framework.SetRequestedTestFilter(EAutomationTestFlags::PerfFilter);
+
+		TArray< FAutomationTestInfo > TestInfos;
+		Framework.GetValidTestNames(TestInfos);
+
+		int32 NumRun = 0;
+		int32 NumFailed = 0;
+		for(auto const& Info : TestInfos)
+		{
+			if(!Info.GetFullTestPath().StartsWith(TestPath))
+			{
+				continue;
+			}
+
+			Framework.StartTestByName(Info.GetTestName(), 0);
+			FAutomationTestExecutionInfo ExecutionInfo;
+			if(!Framework.StopTest(ExecutionInfo))
+			{
+				for(auto const& Entry : ExecutionInfo.GetEntries())
+				{
+					if(Entry.Event.Type == EAutomationEventType::Error)
+					{
+						UE_LOG(LogKantanDocGen, Error, TEXT("[Benchmark] %s: %s"), *Info.GetFullTestPath(), *Entry.Event.Message);
+					}
+				}
+				++NumFailed;
+			}
+			++NumRun;
+		}
+
+		if(NumRun == 0)
+		{
+			UE_LOG(LogKantanDocGen, Error, TEXT("[Benchmark] No benchmark tests found under '%s'."), *TestPath);
+			return false;
+		}
+
+		UE_LOG(LogKantanDocGen, Display, TEXT("[Benchmark] %i of %i benchmark tests under '%s' passed."), NumRun - NumFailed, NumRun, *TestPath);
+		return NumFailed == 0;
+#else
+		UE_LOG(LogKantanDocGen, Error, TEXT("[Benchmark] Benchmarks need a build with automation tests."));
+		return false;
+#endif
+	}
+
+	void ExecXmlBenchmarks(TArray< FString > const& Args)
+	{
+		SetSizeFromArgs(CVarXmlBenchmarkDocs, Args);
+		RunBenchmarkTests(TEXT("KantanDocGen.Benchmark.Xml"));
+	}
+
+	void ExecPipelineBenchmarks(TArray< FString > const& Args)
+	{
+		SetSizeFromArgs(CVarPipelineBenchmarkIterations, Args);
+		RunBenchmarkTests(TEXT("KantanDocGen.Benchmark.Pipeline"));
+	}
+}
+
@@ -0,0 +1,265 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenBenchmark.h"
+#include "KantanDocGenLog.h"
+#include "NodeDocsGenerator.h"
+#include "DocGenSpawnerFilter.h"
+#include "Enumeration/NativeModuleEnumerator.h"
+#include "Enumeration/ContentPathEnumerator.h"
+#include "BlueprintActionDatabase.h"
+#include "BlueprintNodeSpawner.h"
+#include "K2Node.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "AssetRegistryModule.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+
+
+namespace DocGenBenchmark
+{
+	namespace
+	{
+		// Fixed inputs, so that results are comparable between runs of the same engine version
+		const TCHAR* const BenchmarkModules[] = {
+			TEXT("Engine"),
+			TEXT("UMG"),
+			TEXT("AIModule"),
+		};
+		const TCHAR* const BenchmarkContentPath = TEXT("/Engine");
+		UClass* GetBenchmarkNodeClass() { return UKismetMathLibrary::StaticClass(); }
+
+		template < typename TFunc >
+		FResult Measure(FString const& Name, TFunc&& Func)
+		{
+			FResult Result;
+			Result.Name = Name;
+
+			double const StartTime = FPlatformTime::Seconds();
+			{
+				FScopedAllocationCounter Allocs;
+				Func(Result);
+				Result.NumAllocs = Allocs.GetNumAllocs();
+				Result.AllocatedBytes = Allocs.GetAllocatedBytes();
+			}
+			Result.Seconds = FPlatformTime::Seconds() - StartTime;
+
+			return Result;
+		}
+
+		FString GetScratchDir()
+		{
+			return FPaths::ProjectIntermediateDir() / TEXT("KantanDocGen") / TEXT("PipelineBenchmark");
+		}
+	}
+
+
+	TArray< FString > GetPipelineBenchmarkNames()
+	{
+		return {
+			TEXT("Prepass.NativeModule"),
+			TEXT("Prepass.ContentPath"),
+			TEXT("Spawner.IsDocumentable"),
+			TEXT("Pin.ExtractInformation"),
+			TEXT("Pin.ExtractInformation.HoverText"),
+			TEXT("Node.GenerateDocs"),
+		};
+	}
+
+	TArray< FResult > RunPipelineBenchmarks(int32 NumIterations, FString const& OnlyName)
+	{
+		check(IsInGameThread());
+
+		TArray< FResult > Results;
+
+		auto ShouldRun = [&OnlyName](TCHAR const* Name)
+		{
+			return OnlyName.IsEmpty() || OnlyName == Name;
+		};
+
+		// Untimed setup: the asset registry and action database are expensive to build the first time round
+		FModuleManager::LoadModuleChecked< FAssetRegistryModule >("AssetRegistry").Get().SearchAllAssets(true);
+		auto& ActionMap = FBlueprintActionDatabase::Get().GetAllActions();
+
+		TArray< FName > Modules;
+		for(auto Module : BenchmarkModules)
+		{
+			Modules.Add(Module);
+		}
+
+		if(ShouldRun(TEXT("Prepass.NativeModule")))
+		{
+			Results.Add(Measure(TEXT("Prepass.NativeModule"), [&](FResult& Result)
+			{
+				for(int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+				{
+					for(auto const& Module : Modules)
+					{
+						FNativeModuleEnumerator Enumerator(Module);
+						Result.bSucceeded &= Enumerator.EstimatedSize() > 0;
+						Result.OutputBytes += Enumerator.EstimatedSize() * sizeof(UObject*);
+						++Result.NumOps;
+					}
+				}
+			}));
+		}
+
+		if(ShouldRun(TEXT("Prepass.ContentPath")))
+		{
+			Results.Add(Measure(TEXT("Prepass.ContentPath"), [&](FResult& Result)
+			{
+				for(int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+				{
+					FContentPathEnumerator Enumerator({ FName(BenchmarkContentPath) });
+					Result.bSucceeded &= Enumerator.EstimatedSize() > 0;
+					Result.OutputBytes += Enumerator.EstimatedSize() * sizeof(FAssetData);
+					++Result.NumOps;
+				}
+			}));
+		}
+
+		FDocGenSpawnerFilter Filter;
+		if(ShouldRun(TEXT("Spawner.IsDocumentable")))
+		{
+			// Every spawner for every class in the benchmark modules
+			TArray< UBlueprintNodeSpawner* > Spawners;
+			for(auto const& Module : Modules)
+			{
+				FNativeModuleEnumerator Enumerator(Module);
+				while(auto Obj = Enumerator.GetNext())
+				{
+					if(auto ActionList = ActionMap.Find(Obj))
+					{
+						Spawners.Append(*ActionList);
+					}
+				}
+			}
+
+			Results.Add(Measure(TEXT("Spawner.IsDocumentable"), [&](FResult& Result)
+			{
+				for(int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+				{
+					Filter = FDocGenSpawnerFilter();
+					for(auto Spawner : Spawners)
+					{
+						Filter.IsDocumentable(Spawner, false);
+					}
+					Result.NumOps += Spawners.Num();
+				}
+			}));
+			UE_LOG(LogKantanDocGen, Display, TEXT("[Benchmark] %i of %i spawners are documentable. Rejected: %s."), Filter.GetNumAccepted(), Spawners.Num(), *Filter.GetRejectionSummary());
+		}
+
+		if(!ShouldRun(TEXT("Pin.ExtractInformation")) && !ShouldRun(TEXT("Pin.ExtractInformation.HoverText")) && !ShouldRun(TEXT("Node.GenerateDocs")))
+		{
+			return Results;
+		}
+
+		// Spawn the nodes for a single large class, then document them repeatedly
+		auto const ScratchDir = GetScratchDir();
+		IFileManager::Get().DeleteDirectory(*ScratchDir, false, true);
+		{
+			FNodeDocsGenerator DocGen;
+			if(!DocGen.GT_Init(TEXT("Benchmark"), ScratchDir, AActor::StaticClass(), false, false))
+			{
+				UE_LOG(LogKantanDocGen, Error, TEXT("[Benchmark] Failed to initialize doc generator."));
+				return Results;
+			}
+
+			UClass* const NodeClass = GetBenchmarkNodeClass();
+			TArray< TPair< UK2Node*, FNodeDocsGenerator::FNodeProcessingState > > Nodes;
+			if(auto ActionList = ActionMap.Find(NodeClass))
+			{
+				for(auto Spawner : *ActionList)
+				{
+					if(!Filter.IsDocumentable(Spawner, false))
+					{
+						continue;
+					}
+
+					FNodeDocsGenerator::FNodeProcessingState State;
+					if(auto Node = DocGen.GT_InitializeForSpawner(Spawner, NodeClass, State))
+					{
+						Nodes.Emplace(Node, MoveTemp(State));
+					}
+				}
+			}
+
+			// As done during generation, with function docs parsed once and shared by every node
+			if(ShouldRun(TEXT("Pin.ExtractInformation")))
+			{
+				Results.Add(Measure(TEXT("Pin.ExtractInformation"), [&](FResult& Result)
+				{
+					FDocGenFunctionDocCache FunctionDocs;
+					FString Name, Type, Description;
+					for(int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+					{
+						for(auto const& Entry : Nodes)
+						{
+							auto const FunctionDoc = FunctionDocs.FindForNode(Entry.Key);
+							for(auto Pin : Entry.Key->Pins)
+							{
+								FNodeDocsGenerator::ExtractPinInformation(Pin, FunctionDoc.Get(), Name, Type, Description);
+								Result.OutputBytes += (Name.Len() + Type.Len() + Description.Len()) * sizeof(TCHAR);
+								++Result.NumOps;
+							}
+						}
+					}
+				}));
+			}
+
+			// Fallback for nodes that don't wrap a function, parsing each pin's hover text
+			if(ShouldRun(TEXT("Pin.ExtractInformation.HoverText")))
+			{
+				Results.Add(Measure(TEXT("Pin.ExtractInformation.HoverText"), [&](FResult& Result)
+				{
+					FString Name, Type, Description;
+					for(int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+					{
+						for(auto const& Entry : Nodes)
+						{
+							for(auto Pin : Entry.Key->Pins)
+							{
+								FNodeDocsGenerator::ExtractPinInformation(Pin, nullptr, Name, Type, Description);
+								Result.OutputBytes += (Name.Len() + Type.Len() + Description.Len()) * sizeof(TCHAR);
+								++Result.NumOps;
+							}
+						}
+					}
+				}));
+			}
+
+			if(ShouldRun(TEXT("Node.GenerateDocs")))
+			{
+				Results.Add(Measure(TEXT("Node.GenerateDocs"), [&](FResult& Result)
+				{
+					int64 const StartBytes = DocGen.GetStats().XmlBytes;
+					for(int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+					{
+						for(auto& Entry : Nodes)
+						{
+							Result.bSucceeded &= DocGen.GenerateNodeDocs(Entry.Key, Entry.Value);
+							++Result.NumOps;
+						}
+
+						// Don't let the accumulated docs grow across iterations
+						for(auto& Entry : Nodes)
+						{
+							Entry.Value.ClassDoc->Nodes.Reset();
+							Entry.Value.ClassDoc->NodeDocs.Reset();
+						}
+					}
+					Result.OutputBytes = DocGen.GetStats().XmlBytes - StartBytes;
+				}));
+			}
+		}
+		IFileManager::Get().DeleteDirectory(*ScratchDir, false, true);
+
+		return Results;
+	}
+}
@@ -0,0 +1,268 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenBenchmark.h"
+#include "KantanDocGenLog.h"
+#include "DocGenSettings.h"
+#include "DocGenTaskProcessor.h"
+#include "BlueprintActionDatabase.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_FunctionEntry.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GameFramework/Actor.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+
+
+namespace DocGenBenchmark
+{
+	namespace
+	{
+		const TCHAR* const SyntheticPackageRoot = TEXT("/Temp/KantanDocGenScaling");
+
+		FString MakeTooltip(FSyntheticProjectSpec const& Spec, int32 FunctionIdx, TArray< FName > const& PinNames)
+		{
+			static const TCHAR* const Words[] = {
+				TEXT("computes"), TEXT("the"), TEXT("synthetic"), TEXT("value"), TEXT("of"), TEXT("a"),
+				TEXT("benchmark"), TEXT("input"), TEXT("and"), TEXT("returns"), TEXT("nothing"), TEXT("useful"),
+			};
+
+			FString Tooltip = FString::Printf(TEXT("Synthetic function %i"), FunctionIdx);
+			for(int32 WordIdx = FunctionIdx; Tooltip.Len() < Spec.TooltipLength; ++WordIdx)
+			{
+				Tooltip += TEXT(" ");
+				Tooltip += Words[WordIdx % UE_ARRAY_COUNT(Words)];
+			}
+			Tooltip += TEXT(".");
+
+			// Exercise the per pin tooltip parsing too
+			for(auto const& PinName : PinNames)
+			{
+				Tooltip += FString::Printf(TEXT("\n@param %s The %s input."), *PinName.ToString(), *PinName.ToString());
+			}
+
+			return Tooltip;
+		}
+
+		FEdGraphPinType MakePinType(int32 PinIdx)
+		{
+			FEdGraphPinType PinType;
+			switch(PinIdx % 5)
+			{
+			case 0:
+				PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+				break;
+			case 1:
+				PinType.PinCategory = UEdGraphSchema_K2::PC_Int;
+				break;
+			case 2:
+				PinType.PinCategory = UEdGraphSchema_K2::PC_Float;
+				break;
+			case 3:
+				PinType.PinCategory = UEdGraphSchema_K2::PC_String;
+				break;
+			default:
+				PinType.PinCategory = UEdGraphSchema_K2::PC_Object;
+				PinType.PinSubCategoryObject = AActor::StaticClass();
+				break;
+			}
+			return PinType;
+		}
+
+		/** Alternates between function libraries and actor blueprints, so both static and member function nodes are documented */
+		UBlueprint* CreateSyntheticBlueprint(FSyntheticProjectSpec const& Spec, FString const& PackagePath, int32 ClassIdx)
+		{
+			bool const bLibrary = ClassIdx % 2 == 0;
+			FName const Name = *FString::Printf(TEXT("BP_Synthetic%s_%i"), bLibrary ? TEXT("Library") : TEXT("Actor"), ClassIdx);
+
+			UPackage* Package = CreatePackage(*(PackagePath / Name.ToString()));
+			UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(
+				bLibrary ? UBlueprintFunctionLibrary::StaticClass() : AActor::StaticClass(),
+				Package,
+				Name,
+				bLibrary ? BPTYPE_FunctionLibrary : BPTYPE_Normal,
+				UBlueprint::StaticClass(),
+				UBlueprintGeneratedClass::StaticClass()
+			);
+			if(Blueprint == nullptr)
+			{
+				return nullptr;
+			}
+
+			for(int32 FunctionIdx = 0; FunctionIdx < Spec.NumFunctionsPerClass; ++FunctionIdx)
+			{
+				FName const FunctionName = *FString::Printf(TEXT("SyntheticFunction_%i"), FunctionIdx);
+				UEdGraph* Graph = FBlueprintEditorUtils::CreateNewGraph(Blueprint, FunctionName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+				FBlueprintEditorUtils::AddFunctionGraph< UClass >(Blueprint, Graph, true, nullptr);
+
+				TArray< UK2Node_FunctionEntry* > EntryNodes;
+				Graph->GetNodesOfClass(EntryNodes);
+				if(EntryNodes.Num() == 0)
+				{
+					continue;
+				}
+
+				TArray< FName > PinNames;
+				for(int32 PinIdx = 0; PinIdx < Spec.NumPinsPerFunction; ++PinIdx)
+				{
+					PinNames.Add(*FString::Printf(TEXT("Input%i"), PinIdx));
+					EntryNodes[0]->CreateUserDefinedPin(PinNames.Last(), MakePinType(PinIdx), EGPD_Output, false);
+				}
+
+				EntryNodes[0]->MetaData.ToolTip = FText::FromString(MakeTooltip(Spec, FunctionIdx, PinNames));
+			}
+
+			FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+			FBlueprintActionDatabase::Get().RefreshAssetActions(Blueprint);
+
+			return Blueprint;
+		}
+
+		void DestroySyntheticBlueprints(TArray< UBlueprint* > const& Blueprints)
+		{
+			for(auto Blueprint : Blueprints)
+			{
+				FBlueprintActionDatabase::Get().ClearAssetActions(Blueprint);
+
+				for(UObject* Obj : { (UObject*)Blueprint->GeneratedClass, (UObject*)Blueprint->SkeletonGeneratedClass, (UObject*)Blueprint })
+				{
+					if(Obj)
+					{
+						Obj->ClearFlags(RF_Public | RF_Standalone);
+						Obj->MarkPendingKill();
+					}
+				}
+			}
+
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+
+		int64 GetUsedMemory()
+		{
+			return (int64)FPlatformMemory::GetStats().UsedPhysical;
+		}
+
+		void SaveScalingResults(FString const& Path, TArray< FScalingResult > const& Results)
+		{
+			FString Contents;
+			auto Writer = TJsonWriterFactory<>::Create(&Contents);
+
+			Writer->WriteArrayStart();
+			for(auto const& Result : Results)
+			{
+				Writer->WriteObjectStart();
+				Writer->WriteValue(TEXT("classes"), Result.Spec.NumClasses);
+				Writer->WriteValue(TEXT("functions_per_class"), Result.Spec.NumFunctionsPerClass);
+				Writer->WriteValue(TEXT("pins_per_function"), Result.Spec.NumPinsPerFunction);
+				Writer->WriteValue(TEXT("tooltip_length"), Result.Spec.TooltipLength);
+				Writer->WriteValue(TEXT("succeeded"), Result.bSucceeded);
+				Writer->WriteValue(TEXT("nodes"), Result.NumNodes);
+				Writer->WriteValue(TEXT("create_seconds"), Result.CreateSeconds);
+				Writer->WriteValue(TEXT("seconds"), Result.Seconds);
+				Writer->WriteValue(TEXT("peak_memory_bytes"), Result.PeakMemoryBytes);
+				Writer->WriteObjectEnd();
+			}
+			Writer->WriteArrayEnd();
+			Writer->Close();
+
+			if(!FFileHelper::SaveStringToFile(Contents, *Path))
+			{
+				UE_LOG(LogKantanDocGen, Warning, TEXT("[Benchmark] Failed to write scaling results to '%s'."), *Path);
+			}
+		}
+	}
+
+
+	TArray< FScalingResult > RunScalingBenchmarks(
+		FKantanDocGenSettings const& BaseSettings,
+		FSyntheticProjectSpec const& Spec,
+		TArray< int32 > const& ClassCounts,
+		TFunctionRef< FDocGenTaskResult(FKantanDocGenSettings const&) > RunTask)
+	{
+		check(IsInGameThread());
+
+		TArray< FScalingResult > Results;
+
+		for(int32 const NumClasses : ClassCounts)
+		{
+			FScalingResult& Result = Results.AddDefaulted_GetRef();
+			Result.Spec = Spec;
+			Result.Spec.NumClasses = NumClasses;
+
+			// Peak is relative to what was in use before anything for this size was created
+			int64 const BaselineMemory = GetUsedMemory();
+			int64 PeakMemory = BaselineMemory;
+			FDelegateHandle const SamplerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([&PeakMemory](float)
+			{
+				PeakMemory = FMath::Max(PeakMemory, GetUsedMemory());
+				return true;
+			}));
+
+			FKantanDocGenSettings Settings = BaseSettings;
+			Settings.DocumentationTitle = FString::Printf(TEXT("Scaling_%i"), NumClasses);
+			Settings.NativeModules.Empty();
+			Settings.ContentPaths.Empty();
+			Settings.SpecificClasses.Empty();
+			Settings.bIncrementalBuild = false;
+			Settings.bCleanOutputDirectory = true;
+
+			double const CreateStartTime = FPlatformTime::Seconds();
+			FString const PackagePath = FString::Printf(TEXT("%s/%s"), SyntheticPackageRoot, *Settings.DocumentationTitle);
+			TArray< UBlueprint* > Blueprints;
+			for(int32 ClassIdx = 0; ClassIdx < NumClasses; ++ClassIdx)
+			{
+				if(auto Blueprint = CreateSyntheticBlueprint(Result.Spec, PackagePath, ClassIdx))
+				{
+					Blueprints.Add(Blueprint);
+					Settings.SpecificClasses.Add(*Blueprint->GetPathName());
+				}
+			}
+			Result.CreateSeconds = FPlatformTime::Seconds() - CreateStartTime;
+			PeakMemory = FMath::Max(PeakMemory, GetUsedMemory());
+
+			double const StartTime = FPlatformTime::Seconds();
+			FDocGenTaskResult const TaskResult = RunTask(Settings);
+			Result.Seconds = FPlatformTime::Seconds() - StartTime;
+			PeakMemory = FMath::Max(PeakMemory, GetUsedMemory());
+
+			FTicker::GetCoreTicker().RemoveTicker(SamplerHandle);
+
+			Result.bSucceeded = TaskResult.Result == EDocGenResult::Success;
+			Result.NumNodes = TaskResult.NumNodes;
+			Result.PeakMemoryBytes = PeakMemory - BaselineMemory;
+
+			UE_LOG(LogKantanDocGen, Display, TEXT("[Benchmark] Scaling.%i: %s, %i nodes in %.2fs (%.0f nodes/s, %.2fms/node), created in %.2fs, peak memory +%.1fMB"),
+				NumClasses,
+				Result.bSucceeded ? TEXT("succeeded") : TEXT("FAILED"),
+				Result.NumNodes,
+				Result.Seconds,
+				Result.Seconds > 0.0 ? Result.NumNodes / Result.Seconds : 0.0,
+				Result.NumNodes > 0 ? Result.Seconds * 1000.0 / Result.NumNodes : 0.0,
+				Result.CreateSeconds,
+				Result.PeakMemoryBytes / (1024.0 * 1024.0)
+			);
+
+			DestroySyntheticBlueprints(Blueprints);
+		}
+
+		FString const ResultsPath = BaseSettings.OutputDirectory.Path / TEXT("ScalingBenchmark.json");
+		SaveScalingResults(ResultsPath, Results);
+		UE_LOG(LogKantanDocGen, Display, TEXT("[Benchmark] Scaling results written to '%s'."), *ResultsPath);
+
+		return Results;
+	}
+}
+
+
@@ -0,0 +1,238 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenShardMerger.h"
+#include "KantanDocGenLog.h"
+#include "Output/DocGenIntermediateFormat.h"
+#include "Output/DocGenXmlWriter.h"
+#include "Output/DocGenHtmlRenderer.h"
+#include "HAL/FileManager.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/Paths.h"
+#include "Async/ParallelFor.h"
+
+
+FDocGenShardMerger::FDocGenShardMerger(FString const& InDocsTitle, FString const& InMergedDir):
+	DocsTitle(InDocsTitle)
+	, MergedDir(InMergedDir)
+{}
+
+bool FDocGenShardMerger::AddShard(FString const& ShardDir)
+{
+	FString ShardTitle;
+	TArray< FDocGenClassEntry > ShardClasses;
+	if(!DocGenIntermediate::ReadIndex(DocGenIntermediate::GetIndexPath(ShardDir), ShardTitle, ShardClasses))
+	{
+		return false;
+	}
+
+	for(auto const& IndexEntry : ShardClasses)
+	{
+		FDocGenClassEntry ShardClass;
+		if(!DocGenIntermediate::ReadClass(DocGenIntermediate::GetClassPath(ShardDir, IndexEntry.Id), ShardClass))
+		{
+			return false;
+		}
+
+		FMergedClass& Merged = Classes.FindOrAdd(IndexEntry.Id);
+		if(!Merged.ClassDoc.IsValid())
+		{
+			Merged.ClassDoc = MakeShared< FDocGenClassEntry, ESPMode::ThreadSafe >();
+			Merged.ClassDoc->Id = IndexEntry.Id;
+			Merged.ClassDoc->DisplayName = IndexEntry.DisplayName;
+		}
+
+		for(auto& Node : ShardClass.Nodes)
+		{
+			if(!Merged.NodeShards.Contains(Node.Id))
+			{
+				Merged.NodeShards.Add(Node.Id, ShardDir);
+				Merged.ClassDoc->Nodes.Add(MoveTemp(Node));
+			}
+		}
+	}
+
+	ShardDirs.Add(ShardDir);
+
+	UE_LOG(LogKantanDocGen, Log, TEXT("Read shard '%s': %i classes."), *ShardDir, ShardClasses.Num());
+	return true;
+}
+
+TArray< FDocGenShardMerger::FMergedClass const* > FDocGenShardMerger::GetSortedClasses() const
+{
+	TArray< FMergedClass const* > Sorted;
+	for(auto const& Entry : Classes)
+	{
+		Sorted.Add(&Entry.Value);
+	}
+
+	Sorted.Sort([](FMergedClass const& A, FMergedClass const& B)
+	{
+		return A.ClassDoc->Id.Compare(B.ClassDoc->Id, ESearchCase::CaseSensitive) < 0;
+	});
+	return Sorted;
+}
+
+bool FDocGenShardMerger::WriteMerged()
+{
+	auto& FileManager = IFileManager::Get();
+
+	FileManager.DeleteDirectory(*MergedDir, false, true);
+	if(!FileManager.MakeDirectory(*MergedDir, true))
+	{
+		UE_LOG(LogKantanDocGen, Error, TEXT("Failed to create merged docs directory '%s'"), *MergedDir);
+		return false;
+	}
+
+	auto const SortedClasses = GetSortedClasses();
+	FThreadSafeBool bFailed = false;
+
+	ParallelFor(SortedClasses.Num(), [&](int32 Index)
+	{
+		auto& ClassDoc = *SortedClasses[Index]->ClassDoc;
+		auto const& NodeShards = SortedClasses[Index]->NodeShards;
+
+		// Only ever touched by this task
+		ClassDoc.Nodes.Sort([](FDocGenNodeSummary const& A, FDocGenNodeSummary const& B)
+		{
+			return A.Id.Compare(B.Id, ESearchCase::CaseSensitive) < 0;
+		});
+
+		for(auto const& Node : ClassDoc.Nodes)
+		{
+			auto const SourcePath = DocGenIntermediate::GetNodePath(NodeShards.FindChecked(Node.Id), ClassDoc.Id, Node.Id);
+			if(IFileManager::Get().Copy(*DocGenIntermediate::GetNodePath(MergedDir, ClassDoc.Id, Node.Id), *SourcePath) != COPY_OK)
+			{
+				UE_LOG(LogKantanDocGen, Error, TEXT("Failed to copy node doc '%s'"), *SourcePath);
+				bFailed = true;
+			}
+		}
+
+		FDocGenXmlWriter Writer;
+		DocGenIntermediate::WriteClass(Writer, DocsTitle, ClassDoc);
+		if(!Writer.SaveToFile(DocGenIntermediate::GetClassPath(MergedDir, ClassDoc.Id)))
+		{
+			bFailed = true;
+		}
+	});
+
+	{
+		TArray< FDocGenClassEntryPtr > IndexClasses;
+		for(auto Class : SortedClasses)
+		{
+			IndexClasses.Add(Class->ClassDoc);
+		}
+
+		FDocGenXmlWriter Writer;
+		DocGenIntermediate::WriteIndex(Writer, DocsTitle, IndexClasses);
+		if(!Writer.SaveToFile(DocGenIntermediate::GetIndexPath(MergedDir)))
+		{
+			bFailed = true;
+		}
+	}
+
+	// Images are named by content, so the same name from different shards is the same image
+	auto const MergedImageDir = DocGenIntermediate::GetImageDir(MergedDir);
+	TSet< FString > Images;
+	for(auto const& ShardDir : ShardDirs)
+	{
+		auto const ShardImageDir = DocGenIntermediate::GetImageDir(ShardDir);
+
+		TArray< FString > ShardImages;
+		FileManager.FindFiles(ShardImages, *(ShardImageDir / TEXT("*")), true, false);
+		for(auto const& Image : ShardImages)
+		{
+			bool bAlreadyCopied = false;
+			Images.Add(Image, &bAlreadyCopied);
+			if(!bAlreadyCopied && FileManager.Copy(*(MergedImageDir / Image), *(ShardImageDir / Image)) != COPY_OK)
+			{
+				UE_LOG(LogKantanDocGen, Error, TEXT("Failed to copy node image '%s'"), *(ShardImageDir / Image));
+				bFailed = true;
+			}
+		}
+	}
+
+	UE_LOG(LogKantanDocGen, Log, TEXT("Merged %i shards: %i classes, %i nodes, %i images."), ShardDirs.Num(), Classes.Num(), GetNumNodes(), Images.Num());
+	return !bFailed;
+}
+
+bool FDocGenShardMerger::RenderHtml(FDocGenHtmlRenderer& Renderer) const
+{
+	auto const SortedClasses = GetSortedClasses();
+
+	// Nothing is known about the previous output, so remove any classes it has that we don't
+	{
+		TArray< FString > OutputDirs;
+		IFileManager::Get().FindFiles(OutputDirs, *(Renderer.GetOutputDir() / TEXT("*")), false, true);
+
+		TArray< FString > StaleClasses;
+		for(auto const& Dir : OutputDirs)
+		{
+			if(Dir != TEXT("css") && Dir != TEXT("img") && !Classes.Contains(Dir))
+			{
+				StaleClasses.Add(Dir);
+			}
+		}
+		Renderer.RemovePages(StaleClasses, {});
+	}
+
+	FThreadSafeBool bFailed = false;
+	ParallelFor(SortedClasses.Num(), [&](int32 Index)
+	{
+		auto const& Merged = *SortedClasses[Index]->ClassDoc;
+
+		FDocGenClassEntry ClassDoc;
+		ClassDoc.Id = Merged.Id;
+		ClassDoc.DisplayName = Merged.DisplayName;
+		ClassDoc.Nodes = Merged.Nodes;
+
+		for(auto const& Node : ClassDoc.Nodes)
+		{
+			FDocGenNodeEntry& NodeDoc = ClassDoc.NodeDocs.AddDefaulted_GetRef();
+			if(!DocGenIntermediate::ReadNode(DocGenIntermediate::GetNodePath(MergedDir, ClassDoc.Id, Node.Id), NodeDoc))
+			{
+				bFailed = true;
+			}
+			NodeDoc.Id = Node.Id;
+		}
+
+		if(!Renderer.RenderClass(ClassDoc))
+		{
+			bFailed = true;
+		}
+	});
+
+	TArray< FDocGenClassEntryPtr > IndexClasses;
+	for(auto Class : SortedClasses)
+	{
+		IndexClasses.Add(Class->ClassDoc);
+	}
+	if(!Renderer.RenderIndex(IndexClasses))
+	{
+		bFailed = true;
+	}
+
+	TArray< FString > Images;
+	IFileManager::Get().FindFiles(Images, *(DocGenIntermediate::GetImageDir(MergedDir) / TEXT("*")), true, false);
+	if(!Renderer.SyncImages(TSet< FString >(Images)))
+	{
+		bFailed = true;
+	}
+
+	return !bFailed;
+}
+
+int32 FDocGenShardMerger::GetNumNodes() const
+{
+	int32 Count = 0;
+	for(auto const& Entry : Classes)
+	{
+		Count += Entry.Value.ClassDoc->Nodes.Num();
+	}
+	return Count;
+}
+
+
@@ -0,0 +1,54 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "DocGenModel.h"
+
+
+class FDocGenHtmlRenderer;
+
+/*
+Combines the intermediate docs written by separate worker processes, each covering a subset of the sources, into a single doc set.
+Classes and nodes are ordered by id, and where more than one shard documented the same node the first shard added wins,
+so for a fixed shard order the result only depends on what was documented, not on how the work was split.
+*/
+class FDocGenShardMerger
+{
+public:
+	FDocGenShardMerger(FString const& InDocsTitle, FString const& InMergedDir);
+
+public:
+	/** Reads the index and class documents of a shard. Node documents are only read when needed. */
+	bool AddShard(FString const& ShardDir);
+
+	/** Writes the merged index and class documents into the merged directory, along with all node documents and images. */
+	bool WriteMerged();
+
+	/** Renders html for the merged doc set, one class at a time so that node docs are never all held in memory. Call after WriteMerged. */
+	bool RenderHtml(FDocGenHtmlRenderer& Renderer) const;
+
+	int32 GetNumClasses() const { return Classes.Num(); }
+	int32 GetNumNodes() const;
+
+protected:
+	struct FMergedClass
+	{
+		FDocGenClassEntryPtr ClassDoc;		// Node summaries only
+		TMap< FString, FString > NodeShards;	// Node id to the shard directory holding its document
+	};
+
+	TArray< FMergedClass const* > GetSortedClasses() const;
+
+protected:
+	FString DocsTitle;
+	FString MergedDir;
+
+	TMap< FString, FMergedClass > Classes;
+	TArray< FString > ShardDirs;
+};
+
+
@@ -0,0 +1,611 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "KantanDocGenCommandlet.h"
+#include "KantanDocGenLog.h"
+#include "DocGenSettings.h"
+#include "DocGenTaskProcessor.h"
+#include "DocGenShardMerger.h"
+#include "Enumeration/NativeModuleEnumerator.h"
+#include "Enumeration/ContentPathEnumerator.h"
+#include "Enumeration/ClassListEnumerator.h"
+#include "Output/DocGenHtmlRenderer.h"
+#include "Benchmark/DocGenBenchmark.h"
+#include "AssetRegistryModule.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Paths.h"
+#include "Misc/CoreDelegates.h"
+#include "Containers/Ticker.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/UObjectGlobals.h"
+
+
+namespace
+{
+	const TCHAR* const SettingsSection = TEXT("KantanDocGen");
+
+	bool ImportSettingValue(FProperty* Property, void* ValuePtr, FString const& Value)
+	{
+		// Allow directories to be given as plain paths, rather than (Path="...")
+		if(auto StructProp = CastField< FStructProperty >(Property))
+		{
+			if(StructProp->Struct == FDirectoryPath::StaticStruct())
+			{
+				static_cast< FDirectoryPath* >(ValuePtr)->Path = Value;
+				return true;
+			}
+		}
+
+		return Property->ImportText(*Value, ValuePtr, PPF_None, nullptr) != nullptr;
+	}
+
+	// Arrays take one value per element, anything else just the last value given
+	bool ApplySetting(FKantanDocGenSettings& Settings, FProperty* Property, TArray< FString > const& Values)
+	{
+		void* ValuePtr = Property->ContainerPtrToValuePtr< void >(&Settings);
+
+		if(auto ArrayProp = CastField< FArrayProperty >(Property))
+		{
+			FScriptArrayHelper Array(ArrayProp, ValuePtr);
+			Array.EmptyValues();
+			for(auto const& Value : Values)
+			{
+				int32 const Idx = Array.AddValue();
+				if(!ImportSettingValue(ArrayProp->Inner, Array.GetRawPtr(Idx), Value))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		return Values.Num() > 0 && ImportSettingValue(Property, ValuePtr, Values.Last());
+	}
+}
+
+
+UKantanDocGenCommandlet::UKantanDocGenCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UKantanDocGenCommandlet::Main(const FString& Params)
+{
+	if(FParse::Param(*Params, TEXT("help")))
+	{
+		PrintUsage();
+		return EExitCode::Success;
+	}
+
+	if(FParse::Param(*Params, TEXT("Benchmark")))
+	{
+		// Runs the benchmark automation tests at their default sizes, so results are comparable with those from the editor
+		return DocGenBenchmark::RunBenchmarkTests(TEXT("KantanDocGen.Benchmark")) ? EExitCode::Success : EExitCode::GenerationFailed;
+	}
+
+	FKantanDocGenSettings Settings;
+	if(!ParseSettings(Params, Settings))
+	{
+		PrintUsage();
+		return EExitCode::InvalidArguments;
+	}
+
+	// Png node images are rendered with Slate, which is not set up for commandlets. Svg images need no rendering.
+	if(Settings.bGenerateImages && Settings.ImageFormat == EDocGenImageFormat::Png && !FSlateApplication::IsInitialized())
+	{
+		UE_LOG(LogKantanDocGen, Warning, TEXT("Slate rendering is not available, generating docs without node images. Use -ImageFormat=Svg for images without rendering."));
+		Settings.bGenerateImages = false;
+	}
+
+	// Documents its own synthetic classes, so needs no sources
+	if(FParse::Param(*Params, TEXT("ScalingBenchmark")))
+	{
+		return RunScalingBenchmark(Params, Settings);
+	}
+
+	if(!Settings.HasAnySources())
+	{
+		UE_LOG(LogKantanDocGen, Error, TEXT("No modules or content paths were given to document."));
+		PrintUsage();
+		return EExitCode::InvalidArguments;
+	}
+
+	// The asset registry isn't populated up front for commandlets
+	if(Settings.ContentPaths.Num() > 0)
+	{
+		auto& AssetRegistry = FModuleManager::LoadModuleChecked< FAssetRegistryModule >("AssetRegistry").Get();
+		AssetRegistry.SearchAllAssets(true);
+	}
+
+	UE_LOG(LogKantanDocGen, Display, TEXT("Generating '%s' docs to '%s'%s."),
+		*Settings.DocumentationTitle,
+		*Settings.OutputDirectory.Path,
+		Settings.bGenerateImages ? TEXT("") : TEXT(" without node images")
+	);
+
+	int32 NumShards = 1;
+	FParse::Value(*Params, TEXT("Shards="), NumShards);
+	if(NumShards > 1)
+	{
+		return RunSharded(Params, Settings, NumShards);
+	}
+
+	// Set when running as a shard worker
+	FDocGenTaskOptions Options;
+	FParse::Value(*Params, TEXT("IntermediateDir="), Options.IntermediateDir);
+	Options.bIntermediateOnly = FParse::Param(*Params, TEXT("IntermediateOnly"));
+
+	return RunTask(Settings, MoveTemp(Options));
+}
+
+int32 UKantanDocGenCommandlet::RunTask(FKantanDocGenSettings const& Settings, FDocGenTaskOptions Options)
+{
+	FDocGenTaskResult const Result = ExecuteTask(Settings, MoveTemp(Options));
+
+	UE_LOG(LogKantanDocGen, Display, TEXT("Documented %i nodes (%i unchanged) across %i classes in %.1fs, %.1f nodes/s. Excluded %i classes, skipped %i blueprints with nothing to document."),
+		Result.NumNodes,
+		Result.NumReusedNodes,
+		Result.NumClasses,
+		Result.TotalTime,
+		Result.TotalTime > 0.0 ? Result.NumNodes / Result.TotalTime : 0.0,
+		Result.NumExcluded,
+		Result.NumSkippedAssets
+	);
+
+	switch(Result.Result)
+	{
+		case EDocGenResult::Success:
+		UE_LOG(LogKantanDocGen, Display, TEXT("Doc gen succeeded."));
+		return EExitCode::Success;
+		case EDocGenResult::NoNodes:
+		UE_LOG(LogKantanDocGen, Error, TEXT("Doc gen failed, no nodes found to document."));
+		return EExitCode::NoNodes;
+		case EDocGenResult::GenerationFailed:
+		UE_LOG(LogKantanDocGen, Error, TEXT("Doc gen failed, could not generate docs."));
+		return EExitCode::GenerationFailed;
+		case EDocGenResult::ConversionFailed:
+		UE_LOG(LogKantanDocGen, Error, TEXT("Doc gen failed, could not write html output."));
+		return EExitCode::ConversionFailed;
+		default:
+		UE_LOG(LogKantanDocGen, Error, TEXT("Doc gen was cancelled."));
+		return EExitCode::Cancelled;
+	}
+}
+
+int32 UKantanDocGenCommandlet::RunScalingBenchmark(FString const& Params, FKantanDocGenSettings const& Settings)
+{
+	DocGenBenchmark::FSyntheticProjectSpec Spec;
+	FParse::Value(*Params, TEXT("Functions="), Spec.NumFunctionsPerClass);
+	FParse::Value(*Params, TEXT("Pins="), Spec.NumPinsPerFunction);
+	FParse::Value(*Params, TEXT("TooltipLength="), Spec.TooltipLength);
+
+	FString ClassCountsStr = TEXT("10,100,1000");
+	FParse::Value(*Params, TEXT("Classes="), ClassCountsStr, false);
+
+	TArray< FString > ClassCountStrs;
+	ClassCountsStr.ParseIntoArray(ClassCountStrs, TEXT(","), true);
+
+	TArray< int32 > ClassCounts;
+	for(auto const& CountStr : ClassCountStrs)
+	{
+		int32 const Count = FCString::Atoi(*CountStr);
+		if(Count <= 0)
+		{
+			UE_LOG(LogKantanDocGen, Error, TEXT("Invalid class count '%s'."), *CountStr);
+			return EExitCode::InvalidArguments;
+		}
+		ClassCounts.Add(Count);
+	}
+
+	auto const Results = DocGenBenchmark::RunScalingBenchmarks(Settings, Spec, ClassCounts, [this](FKantanDocGenSettings const& TaskSettings)
+	{
+		return ExecuteTask(TaskSettings, FDocGenTaskOptions());
+	});
+
+	bool const bAllSucceeded = Results.FindByPredicate([](DocGenBenchmark::FScalingResult const& Result) { return !Result.bSucceeded; }) == nullptr;
+	return bAllSucceeded ? EExitCode::Success : EExitCode::GenerationFailed;
+}
+
+FDocGenTaskResult UKantanDocGenCommandlet::ExecuteTask(FKantanDocGenSettings const& Settings, FDocGenTaskOptions Options)
+{
+	FDocGenTaskResult Result;
+	FThreadSafeBool bComplete = false;
+
+	FDocGenTaskProcessor Processor;
+	Options.OnComplete = FOnDocGenTaskComplete::CreateLambda([&Result, &bComplete](FDocGenTaskResult const& InResult)
+	{
+		Result = InResult;
+		bComplete = true;
+	});
+	Processor.QueueTask(Settings, MoveTemp(Options));
+	Processor.StartWorker(TPri_Normal);
+
+	// Stand in for the editor loop, so the processor's game thread work gets run
+	double LastTime = FPlatformTime::Seconds();
+	while(!bComplete && Processor.IsRunning())
+	{
+		if(IsEngineExitRequested())
+		{
+			Processor.Stop();
+		}
+
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+		// Progress any blueprints being prefetched, as the engine loop would
+		if(IsAsyncLoading())
+		{
+			ProcessAsyncLoading(true, false, 0.005f);
+		}
+
+		double const Now = FPlatformTime::Seconds();
+		FTicker::GetCoreTicker().Tick((float)(Now - LastTime));
+		LastTime = Now;
+
+		FPlatformProcess::Sleep(0.0f);
+	}
+
+	Processor.ShutdownWorker();
+
+	return Result;
+}
+
+int32 UKantanDocGenCommandlet::RunSharded(FString const& Params, FKantanDocGenSettings const& Settings, int32 NumShards)
+{
+	double const StartTime = FPlatformTime::Seconds();
+
+	// Every module, content path and specific class is a unit of work, sized by the number of objects it has to enumerate
+	enum class EUnitKind
+	{
+		NativeModule,
+		ContentPath,
+		SpecificClass,
+	};
+
+	struct FWorkUnit
+	{
+		FName Name;
+		EUnitKind Kind;
+		int32 Size;
+	};
+
+	FDocGenExclusionFilter const Exclusions(Settings.ExcludedClasses);
+
+	TArray< FWorkUnit > Units;
+	for(auto const& Module : Settings.NativeModules)
+	{
+		Units.Add(FWorkUnit{ Module, EUnitKind::NativeModule, FNativeModuleEnumerator(Module, Exclusions).EstimatedSize() });
+	}
+	for(auto const& Path : Settings.ContentPaths)
+	{
+		FName const PathName(*Path.Path);
+		Units.Add(FWorkUnit{ PathName, EUnitKind::ContentPath, FContentPathEnumerator({ PathName }, Exclusions).EstimatedSize() });
+	}
+	for(auto const& Class : Settings.SpecificClasses)
+	{
+		Units.Add(FWorkUnit{ Class, EUnitKind::SpecificClass, FClassListEnumerator({ Class }, Exclusions).EstimatedSize() });
+	}
+
+	// Nothing to split, so no point paying for worker processes
+	if(Units.Num() < 2)
+	{
+		UE_LOG(LogKantanDocGen, Display, TEXT("Only %i unit of work, running without shards."), Units.Num());
+		return RunTask(Settings, FDocGenTaskOptions());
+	}
+
+	// Largest first onto the least loaded shard. Ties are broken by name so the split is the same from run to run.
+	Units.Sort([](FWorkUnit const& A, FWorkUnit const& B)
+	{
+		return A.Size != B.Size ? A.Size > B.Size : A.Name.LexicalLess(B.Name);
+	});
+
+	struct FShard
+	{
+		TArray< FString > NativeModules;
+		TArray< FString > ContentPaths;
+		TArray< FString > SpecificClasses;
+		int32 Size = 0;
+		int32 NumUnits = 0;
+		FString Dir;
+		FProcHandle Proc;
+		int32 ReturnCode = 0;
+	};
+
+	NumShards = FMath::Min(NumShards, Units.Num());
+	TArray< FShard > Shards;
+	Shards.SetNum(NumShards);
+
+	for(auto const& Unit : Units)
+	{
+		FShard* Target = &Shards[0];
+		for(auto& Shard : Shards)
+		{
+			// Ties (such as units with no estimate) go to the shard with fewest units, so that none are left empty
+			if(Shard.Size < Target->Size || (Shard.Size == Target->Size && Shard.NumUnits < Target->NumUnits))
+			{
+				Target = &Shard;
+			}
+		}
+
+		switch(Unit.Kind)
+		{
+			case EUnitKind::NativeModule:
+			Target->NativeModules.Add(Unit.Name.ToString());
+			break;
+			case EUnitKind::ContentPath:
+			Target->ContentPaths.Add(Unit.Name.ToString());
+			break;
+			case EUnitKind::SpecificClass:
+			Target->SpecificClasses.Add(Unit.Name.ToString());
+			break;
+		}
+		++Target->NumUnits;
+		Target->Size += Unit.Size;
+	}
+
+	// A worker with no sources would fail on its arguments
+	Shards.RemoveAll([](FShard const& Shard)
+	{
+		return Shard.NumUnits == 0;
+	});
+
+	// Workers get everything we were given, other than what the coordinator decides per shard
+	FString WorkerParams;
+	{
+		TSet< FString > const CoordinatorParams = {
+			TEXT("run"), TEXT("Shards"), TEXT("NativeModules"), TEXT("ContentPaths"), TEXT("SpecificClasses"), TEXT("IntermediateDir"), TEXT("IntermediateOnly"), TEXT("abslog"),
+		};
+
+		const TCHAR* Stream = *Params;
+		FString Token;
+		while(FParse::Token(Stream, Token, false))
+		{
+			if(!Token.StartsWith(TEXT("-")))
+			{
+				continue;
+			}
+
+			FString Name = Token.Mid(1);
+			int32 EqualsIdx = INDEX_NONE;
+			if(Name.FindChar(TEXT('='), EqualsIdx))
+			{
+				Name = Name.Left(EqualsIdx);
+			}
+
+			if(!CoordinatorParams.Contains(Name))
+			{
+				WorkerParams += TEXT(" ") + Token;
+			}
+		}
+	}
+
+	FString const ShardsDir = FDocGenTaskProcessor::GetDefaultIntermediateDir(Settings) + TEXT("_Shards");
+	FString const ProjectPath = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+
+	for(int32 Idx = 0; Idx < Shards.Num(); ++Idx)
+	{
+		auto& Shard = Shards[Idx];
+		Shard.Dir = FPaths::ConvertRelativePathToFull(ShardsDir / FString::Printf(TEXT("Shard%i"), Idx));
+
+		FString const Args = FString::Printf(TEXT("\"%s\" -run=KantanDocGen%s -NativeModules=%s -ContentPaths=%s -SpecificClasses=%s -IntermediateDir=\"%s\" -IntermediateOnly -abslog=\"%s\" -unattended"),
+			*ProjectPath,
+			*WorkerParams,
+			*FString::Join(Shard.NativeModules, TEXT(",")),
+			*FString::Join(Shard.ContentPaths, TEXT(",")),
+			*FString::Join(Shard.SpecificClasses, TEXT(",")),
+			*Shard.Dir,
+			*(Shard.Dir + TEXT(".log"))
+		);
+
+		UE_LOG(LogKantanDocGen, Display, TEXT("Shard %i: %i modules, %i content paths, %i classes, estimated size %i."), Idx, Shard.NativeModules.Num(), Shard.ContentPaths.Num(), Shard.SpecificClasses.Num(), Shard.Size);
+		UE_LOG(LogKantanDocGen, Log, TEXT("Launching: %s %s"), FPlatformProcess::ExecutablePath(), *Args);
+
+		Shard.Proc = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Args, false, true, true, nullptr, 0, nullptr, nullptr);
+		if(!Shard.Proc.IsValid())
+		{
+			UE_LOG(LogKantanDocGen, Error, TEXT("Failed to launch worker process for shard %i."), Idx);
+			Shard.ReturnCode = EExitCode::GenerationFailed;
+		}
+	}
+
+	// Wait for all the workers
+	for(bool bAnyRunning = true; bAnyRunning; )
+	{
+		bAnyRunning = false;
+		for(auto& Shard : Shards)
+		{
+			if(Shard.Proc.IsValid())
+			{
+				if(IsEngineExitRequested())
+				{
+					FPlatformProcess::TerminateProc(Shard.Proc, true);
+				}
+
+				if(FPlatformProcess::GetProcReturnCode(Shard.Proc, &Shard.ReturnCode))
+				{
+					FPlatformProcess::CloseProc(Shard.Proc);
+					Shard.Proc.Reset();
+				}
+				else
+				{
+					bAnyRunning = true;
+				}
+			}
+		}
+
+		FPlatformProcess::Sleep(0.1f);
+	}
+
+	double const GenerationTime = FPlatformTime::Seconds() - StartTime;
+
+	// Merge in shard order. Shards without anything to document don't contribute.
+	FDocGenShardMerger Merger(Settings.DocumentationTitle, FDocGenTaskProcessor::GetDefaultIntermediateDir(Settings));
+	for(int32 Idx = 0; Idx < Shards.Num(); ++Idx)
+	{
+		auto const& Shard = Shards[Idx];
+		if(Shard.ReturnCode == EExitCode::NoNodes)
+		{
+			continue;
+		}
+
+		if(Shard.ReturnCode != EExitCode::Success)
+		{
+			UE_LOG(LogKantanDocGen, Error, TEXT("Shard %i failed (code %i), see '%s.log'."), Idx, Shard.ReturnCode, *Shard.Dir);
+			return Shard.ReturnCode == EExitCode::Cancelled ? EExitCode::Cancelled : EExitCode::GenerationFailed;
+		}
+
+		if(!Merger.AddShard(Shard.Dir))
+		{
+			UE_LOG(LogKantanDocGen, Error, TEXT("Failed to read docs for shard %i."), Idx);
+			return EExitCode::GenerationFailed;
+		}
+	}
+
+	if(Merger.GetNumNodes() == 0)
+	{
+		UE_LOG(LogKantanDocGen, Error, TEXT("Doc gen failed, no nodes found to document."));
+		return EExitCode::NoNodes;
+	}
+
+	if(!Merger.WriteMerged())
+	{
+		UE_LOG(LogKantanDocGen, Error, TEXT("Failed to write merged docs."));
+		return EExitCode::GenerationFailed;
+	}
+
+	if(Settings.bUseLegacyConversionTool)
+	{
+		UE_LOG(LogKantanDocGen, Warning, TEXT("Sharded runs always use the built-in html renderer."));
+	}
+
+	FDocGenHtmlRenderer Renderer(Settings.DocumentationTitle, FDocGenTaskProcessor::GetDefaultIntermediateDir(Settings), Settings.OutputDirectory.Path / Settings.DocumentationTitle);
+	FString const StylesheetPath = FDocGenHtmlRenderer::GetDefaultStylesheetPath();
+	if(StylesheetPath.IsEmpty() || !Renderer.PrepareOutput(StylesheetPath, Settings.bCleanOutputDirectory) || !Merger.RenderHtml(Renderer))
+	{
+		UE_LOG(LogKantanDocGen, Error, TEXT("Doc gen failed, could not write html output."));
+		return EExitCode::ConversionFailed;
+	}
+
+	double const TotalTime = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogKantanDocGen, Display, TEXT("Documented %i nodes across %i classes with %i shards in %.1fs (%.1fs generating, %.1fs merging), %.1f nodes/s."),
+		Merger.GetNumNodes(),
+		Merger.GetNumClasses(),
+		Shards.Num(),
+		TotalTime,
+		GenerationTime,
+		TotalTime - GenerationTime,
+		TotalTime > 0.0 ? Merger.GetNumNodes() / TotalTime : 0.0
+	);
+
+	UE_LOG(LogKantanDocGen, Display, TEXT("Doc gen succeeded."));
+	return EExitCode::Success;
+}
+
+bool UKantanDocGenCommandlet::ParseSettings(FString const& Params, FKantanDocGenSettings& OutSettings) const
+{
+	OutSettings = FKantanDocGenSettings();
+	UKantanDocGenSettingsObject::InitDefaults(OutSettings);
+
+	// There are no editor frames to keep responsive
+	OutSettings.GameThreadFrameBudgetMs = 100.0f;
+
+	TArray< FString > Tokens;
+	TArray< FString > Switches;
+	TMap< FString, FString > ParamVals;
+	UCommandlet::ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	FConfigFile SettingsIni;
+	FConfigSection const* IniSection = nullptr;
+	if(auto IniPath = ParamVals.Find(TEXT("Settings")))
+	{
+		if(!FPaths::FileExists(*IniPath))
+		{
+			UE_LOG(LogKantanDocGen, Error, TEXT("Settings file '%s' not found."), **IniPath);
+			return false;
+		}
+
+		SettingsIni.Read(*IniPath);
+		IniSection = SettingsIni.Find(SettingsSection);
+		if(IniSection == nullptr)
+		{
+			UE_LOG(LogKantanDocGen, Warning, TEXT("Settings file '%s' has no [%s] section."), **IniPath, SettingsSection);
+		}
+	}
+
+	for(TFieldIterator< FProperty > It(FKantanDocGenSettings::StaticStruct()); It; ++It)
+	{
+		FProperty* Property = *It;
+		FString const Name = Property->GetName();
+		bool const bIsBool = Property->IsA< FBoolProperty >();
+
+		TArray< FString > Values;
+
+		if(IniSection)
+		{
+			TArray< FConfigValue > IniValues;
+			IniSection->MultiFind(Property->GetFName(), IniValues, true);
+			for(auto const& IniValue : IniValues)
+			{
+				Values.Add(IniValue.GetValue());
+			}
+		}
+
+		FString const ShortName = bIsBool && Name.StartsWith(TEXT("b"), ESearchCase::CaseSensitive) ? Name.RightChop(1) : Name;
+		FString const* CmdLineValue = ParamVals.Find(Name);
+		if(CmdLineValue == nullptr)
+		{
+			CmdLineValue = ParamVals.Find(ShortName);
+		}
+
+		if(CmdLineValue)
+		{
+			// An empty value clears an array
+			Values.Reset();
+			CmdLineValue->ParseIntoArray(Values, TEXT(","), true);
+		}
+		else if(bIsBool && (Switches.Contains(Name) || Switches.Contains(ShortName)))
+		{
+			Values = { TEXT("True") };
+		}
+		else if(Values.Num() == 0)
+		{
+			continue;
+		}
+
+		if(!ApplySetting(OutSettings, Property, Values))
+		{
+			UE_LOG(LogKantanDocGen, Error, TEXT("Invalid value for setting '%s': '%s'."), *Name, *FString::Join(Values, TEXT(",")));
+			return false;
+		}
+	}
+
+	if(Switches.Contains(TEXT("NoImages")))
+	{
+		OutSettings.bGenerateImages = false;
+	}
+
+	return true;
+}
+
+void UKantanDocGenCommandlet::PrintUsage() const
+{
+	UE_LOG(LogKantanDocGen, Display, TEXT("Usage: -run=KantanDocGen [-Settings=<ini file>] [-<Setting>=<Value> ...] [-NoImages] [-Shards=<N>] | -Benchmark"));
+	UE_LOG(LogKantanDocGen, Display, TEXT("       -run=KantanDocGen -ScalingBenchmark [-Classes=<N>,<N>,...] [-Functions=<N>] [-Pins=<N>] [-TooltipLength=<N>] [-<Setting>=<Value> ...]"));
+	UE_LOG(LogKantanDocGen, Display, TEXT("Settings (also read from the [%s] section of the ini file):"), SettingsSection);
+	for(TFieldIterator< FProperty > It(FKantanDocGenSettings::StaticStruct()); It; ++It)
+	{
+		UE_LOG(LogKantanDocGen, Display, TEXT("  %s"), *It->GetName());
+	}
+	UE_LOG(LogKantanDocGen, Display, TEXT("Exit codes: 0 success, 1 invalid arguments, 2 no nodes found, 3 generation failed, 4 html output failed, 5 cancelled."));
+}
+
+
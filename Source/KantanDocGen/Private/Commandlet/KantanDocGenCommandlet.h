@@ -0,0 +1,63 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "KantanDocGenCommandlet.generated.h"
+
+
+struct FKantanDocGenSettings;
+struct FDocGenTaskOptions;
+struct FDocGenTaskResult;
+
+/*
+Generates docs without the editor UI, for use on build machines.
+
+UE4Editor-Cmd <Project> -run=KantanDocGen [-Settings=<ini file>] [-<Setting>=<Value> ...] [-NoImages] [-Shards=<N>]
+
+Settings are the property names of FKantanDocGenSettings, read from the [KantanDocGen] section of the ini file
+and then overridden from the command line. Array values are comma separated on the command line, or given as
+repeated keys in the ini file. Boolean settings can also be given as switches, with or without the 'b' prefix.
+
+With -Shards, the modules and content paths are split across that many worker processes (running this commandlet with
+-IntermediateOnly), and their intermediate docs merged before rendering html.
+
+With -ScalingBenchmark, synthetic blueprints are generated for each of the -Classes counts and documented with the other
+settings given, recording how time and memory scale with the size of the project.
+*/
+UCLASS()
+class UKantanDocGenCommandlet: public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UKantanDocGenCommandlet();
+
+public:
+	enum EExitCode: int32
+	{
+		Success = 0,
+		InvalidArguments = 1,
+		NoNodes = 2,
+		GenerationFailed = 3,
+		ConversionFailed = 4,
+		Cancelled = 5,
+	};
+
+public:
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+	int32 RunTask(FKantanDocGenSettings const& Settings, FDocGenTaskOptions Options);
+	FDocGenTaskResult ExecuteTask(FKantanDocGenSettings const& Settings, FDocGenTaskOptions Options);
+	int32 RunScalingBenchmark(FString const& Params, FKantanDocGenSettings const& Settings);
+	int32 RunSharded(FString const& Params, FKantanDocGenSettings const& Settings, int32 NumShards);
+	bool ParseSettings(FString const& Params, FKantanDocGenSettings& OutSettings) const;
+	void PrintUsage() const;
+};
+
+
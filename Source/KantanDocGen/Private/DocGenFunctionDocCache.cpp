@@ -0,0 +1,141 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenFunctionDocCache.h"
+#include "KantanDocGenTrace.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Event.h"
+#include "Misc/ScopeLock.h"
+
+
+namespace
+{
+	// Splits at the first run of whitespace, so tags and names may be followed by tabs as well as spaces
+	void SplitAtWhitespace(FString const& In, FString& OutFirst, FString& OutRest)
+	{
+		int32 Idx = 0;
+		while(Idx < In.Len() && !FChar::IsWhitespace(In[Idx]))
+		{
+			++Idx;
+		}
+
+		OutFirst = In.Left(Idx);
+		OutRest = In.Mid(Idx).TrimStart();
+	}
+}
+
+FString const* FDocGenFunctionDoc::FindPinDoc(FName PinName) const
+{
+	if(PinName == UEdGraphSchema_K2::PN_ReturnValue)
+	{
+		return ReturnValue.IsEmpty() ? nullptr : &ReturnValue;
+	}
+	return Params.Find(PinName);
+}
+
+FDocGenFunctionDocPtr FDocGenFunctionDocCache::FindForNode(UEdGraphNode const* Node)
+{
+	auto Function = GetDocumentedFunction(Node);
+	return Function ? Find(Function) : nullptr;
+}
+
+FDocGenFunctionDocPtr FDocGenFunctionDocCache::Find(UFunction const* Function)
+{
+	check(Function);
+
+	{
+		FScopeLock Lock(&CacheCS);
+		if(auto Existing = Cache.Find(Function))
+		{
+			return *Existing;
+		}
+	}
+
+	// Parse outside the lock, at worst the same function is parsed twice
+	FDocGenFunctionDocPtr Doc = MakeShared< FDocGenFunctionDoc, ESPMode::ThreadSafe >(Parse(Function->GetToolTipText().ToString()));
+
+	FScopeLock Lock(&CacheCS);
+	return Cache.FindOrAdd(Function, Doc);
+}
+
+void FDocGenFunctionDocCache::Reset()
+{
+	FScopeLock Lock(&CacheCS);
+	Cache.Empty();
+}
+
+UFunction const* FDocGenFunctionDocCache::GetDocumentedFunction(UEdGraphNode const* Node)
+{
+	if(auto FuncNode = Cast< UK2Node_CallFunction >(Node))
+	{
+		return FuncNode->GetTargetFunction();
+	}
+	if(auto EventNode = Cast< UK2Node_Event >(Node))
+	{
+		return EventNode->FindEventSignatureFunction();
+	}
+	return nullptr;
+}
+
+FDocGenFunctionDoc FDocGenFunctionDocCache::Parse(FString const& Tooltip)
+{
+	KANTANDOCGEN_TRACE_SCOPE("ParseFunctionDoc");
+
+	FDocGenFunctionDoc Doc;
+
+	// Text following a tag continues until the next tag. Tags we don't document (@see, @note, etc.) are dropped along with their text.
+	FString* Current = &Doc.Description;
+	TCHAR const* Separator = TEXT("\n");
+
+	TArray< FString > Lines;
+	Tooltip.ParseIntoArrayLines(Lines, false);
+	for(auto const& RawLine : Lines)
+	{
+		FString Line = RawLine.TrimStartAndEnd();
+		if(Line.StartsWith(TEXT("@")))
+		{
+			FString Tag, Rest;
+			SplitAtWhitespace(Line, Tag, Rest);
+
+			Current = nullptr;
+			Separator = TEXT(" ");
+			if(Tag.Equals(TEXT("@param")))
+			{
+				FString Name, Desc;
+				SplitAtWhitespace(Rest, Name, Desc);
+				if(!Name.IsEmpty())
+				{
+					Current = &Doc.Params.Add(FName(*Name), Desc);
+				}
+			}
+			else if(Tag.Equals(TEXT("@return")) || Tag.Equals(TEXT("@returns")))
+			{
+				Doc.ReturnValue = Rest;
+				Current = &Doc.ReturnValue;
+			}
+		}
+		else if(Current)
+		{
+			if(!Current->IsEmpty())
+			{
+				Current->Append(Separator);
+			}
+			Current->Append(Line);
+		}
+	}
+
+	Doc.Description.TrimStartAndEndInline();
+	for(auto& Param : Doc.Params)
+	{
+		Param.Value.TrimEndInline();
+	}
+	Doc.ReturnValue.TrimEndInline();
+
+	return Doc;
+}
+
+
@@ -0,0 +1,55 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "HAL/CriticalSection.h"
+
+
+class UFunction;
+class UEdGraphNode;
+
+/* Documentation of a function, parsed from its tooltip. */
+struct FDocGenFunctionDoc
+{
+	/** Everything before the first @ tag */
+	FString Description;
+	/** From @param lines, keyed by parameter name */
+	TMap< FName, FString > Params;
+	/** From the @return line */
+	FString ReturnValue;
+
+	/** Documentation for the pin representing the given parameter (or the return value), or null if there is none */
+	FString const* FindPinDoc(FName PinName) const;
+};
+
+typedef TSharedPtr< FDocGenFunctionDoc const, ESPMode::ThreadSafe > FDocGenFunctionDocPtr;
+
+/*
+Parses function tooltips once, however many nodes wrap the same function.
+Thread safe, since nodes are hashed on the game thread and documented on the worker.
+*/
+class FDocGenFunctionDocCache
+{
+public:
+	/** Null if the node's pins don't represent the parameters of a function */
+	FDocGenFunctionDocPtr FindForNode(UEdGraphNode const* Node);
+	FDocGenFunctionDocPtr Find(UFunction const* Function);
+
+	void Reset();
+
+	/** The function whose parameters the node's pins represent, if any */
+	static UFunction const* GetDocumentedFunction(UEdGraphNode const* Node);
+	static FDocGenFunctionDoc Parse(FString const& Tooltip);
+
+protected:
+	FCriticalSection CacheCS;
+	TMap< TWeakObjectPtr< UFunction const >, FDocGenFunctionDocPtr > Cache;
+};
+
+
@@ -0,0 +1,123 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenManifest.h"
+#include "KantanDocGenLog.h"
+#include "Misc/FileHelper.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+
+namespace
+{
+	// Bump whenever the format of the manifest changes
+	const int32 ManifestVersion = 2;
+}
+
+
+bool FDocGenManifest::Load(FString const& Path)
+{
+	Reset();
+
+	FString Contents;
+	if(!FFileHelper::LoadFileToString(Contents, *Path))
+	{
+		return false;
+	}
+
+	TSharedPtr< FJsonObject > Root;
+	auto Reader = TJsonReaderFactory<>::Create(Contents);
+	if(!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to parse doc gen manifest '%s', ignoring."), *Path);
+		return false;
+	}
+
+	int32 Version = 0;
+	if(!Root->TryGetNumberField(TEXT("version"), Version) || Version != ManifestVersion)
+	{
+		UE_LOG(LogKantanDocGen, Log, TEXT("Doc gen manifest '%s' is from a different version, ignoring."), *Path);
+		return false;
+	}
+
+	Root->TryGetStringField(TEXT("index"), IndexHash);
+
+	const TSharedPtr< FJsonObject >* ClassesObj = nullptr;
+	if(Root->TryGetObjectField(TEXT("classes"), ClassesObj))
+	{
+		for(auto const& Entry : (*ClassesObj)->Values)
+		{
+			Classes.Add(Entry.Key, Entry.Value->AsString());
+		}
+	}
+
+	const TArray< TSharedPtr< FJsonValue > >* NodesArray = nullptr;
+	if(Root->TryGetArrayField(TEXT("nodes"), NodesArray))
+	{
+		for(auto const& Value : *NodesArray)
+		{
+			auto const& NodeObj = Value->AsObject();
+			if(!NodeObj.IsValid())
+			{
+				continue;
+			}
+
+			FNodeRecord Record;
+			Record.ClassId = NodeObj->GetStringField(TEXT("class"));
+			Record.NodeId = NodeObj->GetStringField(TEXT("id"));
+			Record.Hash = NodeObj->GetStringField(TEXT("hash"));
+			Record.ImageFilename = NodeObj->GetStringField(TEXT("image"));
+			Nodes.Add(MakeNodeKey(Record.ClassId, Record.NodeId), MoveTemp(Record));
+		}
+	}
+
+	return true;
+}
+
+bool FDocGenManifest::Save(FString const& Path) const
+{
+	FString Contents;
+	auto Writer = TJsonWriterFactory<>::Create(&Contents);
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("version"), ManifestVersion);
+	Writer->WriteValue(TEXT("index"), IndexHash);
+
+	Writer->WriteObjectStart(TEXT("classes"));
+	for(auto const& Entry : Classes)
+	{
+		Writer->WriteValue(Entry.Key, Entry.Value);
+	}
+	Writer->WriteObjectEnd();
+
+	Writer->WriteArrayStart(TEXT("nodes"));
+	for(auto const& Entry : Nodes)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("class"), Entry.Value.ClassId);
+		Writer->WriteValue(TEXT("id"), Entry.Value.NodeId);
+		Writer->WriteValue(TEXT("hash"), Entry.Value.Hash);
+		Writer->WriteValue(TEXT("image"), Entry.Value.ImageFilename);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	return FFileHelper::SaveStringToFile(Contents, *Path);
+}
+
+void FDocGenManifest::Reset()
+{
+	Nodes.Empty();
+	Classes.Empty();
+	IndexHash.Empty();
+}
+
+
@@ -0,0 +1,88 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/SecureHash.h"
+
+
+/*
+Record of the content hashes of everything written to an intermediate directory by a previous run.
+Used to skip regeneration of nodes, classes and the index when their inputs have not changed.
+*/
+class FDocGenManifest
+{
+public:
+	struct FNodeRecord
+	{
+		FString ClassId;
+		FString NodeId;
+		FString Hash;
+		FString ImageFilename;	// Within the shared image directory
+	};
+
+public:
+	bool Load(FString const& Path);
+	bool Save(FString const& Path) const;
+
+	void Reset();
+
+	static FString MakeNodeKey(FString const& ClassId, FString const& NodeId)
+	{
+		return ClassId / NodeId;
+	}
+
+public:
+	TMap< FString, FNodeRecord > Nodes;
+	TMap< FString, FString > Classes;
+	FString IndexHash;
+};
+
+
+/* Accumulates a content hash from a sequence of strings. */
+class FDocGenHashBuilder
+{
+public:
+	FDocGenHashBuilder& Add(FString const& Value)
+	{
+		// Include the length, so that boundaries between values affect the hash
+		int32 const Len = Value.Len();
+		Sha.Update(reinterpret_cast< uint8 const* >(&Len), sizeof(Len));
+		Sha.Update(reinterpret_cast< uint8 const* >(*Value), Len * sizeof(TCHAR));
+		return *this;
+	}
+
+	FDocGenHashBuilder& Add(FText const& Value)
+	{
+		return Add(Value.ToString());
+	}
+
+	FDocGenHashBuilder& Add(FName const& Value)
+	{
+		return Add(Value.ToString());
+	}
+
+	FDocGenHashBuilder& Add(int64 Value)
+	{
+		Sha.Update(reinterpret_cast< uint8 const* >(&Value), sizeof(Value));
+		return *this;
+	}
+
+	FString Finalize()
+	{
+		Sha.Final();
+
+		FSHAHash Hash;
+		Sha.GetHash(Hash.Hash);
+		return Hash.ToString();
+	}
+
+protected:
+	FSHA1 Sha;
+};
+
+
@@ -0,0 +1,61 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/*
+In-memory form of the generated documentation.
+Populated by FNodeDocsGenerator, and consumed both by the intermediate xml writer and the html renderer.
+*/
+
+struct FDocGenParamEntry
+{
+	FString Name;
+	FString Type;
+	FString Description;
+};
+
+struct FDocGenNodeEntry
+{
+	FString Id;
+	FString ShortTitle;
+	FString FullTitle;
+	FString Description;
+	FString ImagePath;	// Relative to the node document
+	FString Category;
+
+	TArray< FDocGenParamEntry > Inputs;
+	TArray< FDocGenParamEntry > Outputs;
+};
+
+// What a class document needs to know about each of its nodes
+struct FDocGenNodeSummary
+{
+	FString Id;
+	FString ShortTitle;
+};
+
+struct FDocGenClassEntry
+{
+	FString Id;
+	FString DisplayName;
+
+	// Every node documented for this class
+	TArray< FDocGenNodeSummary > Nodes;
+
+	// Full docs for nodes whose pages have not yet been rendered
+	TArray< FDocGenNodeEntry > NodeDocs;
+
+	// False if nothing in the class document itself has changed since the last run
+	bool bDirty = true;
+};
+
+typedef TSharedPtr< FDocGenClassEntry, ESPMode::ThreadSafe > FDocGenClassEntryPtr;
+
+
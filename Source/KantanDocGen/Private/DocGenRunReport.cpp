@@ -0,0 +1,250 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenRunReport.h"
+#include "KantanDocGenLog.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Serialization/JsonWriter.h"
+
+
+namespace
+{
+	// Bump whenever the format of the report changes
+	const int32 ReportVersion = 1;
+}
+
+
+void FDocGenRunReport::BeginPhase(FString const& Name)
+{
+	EndPhase();
+
+	Phases.Add(FPhase{ Name, 0.0 });
+	PhaseStartTime = FPlatformTime::Seconds();
+	bInPhase = true;
+}
+
+void FDocGenRunReport::EndPhase()
+{
+	if(bInPhase)
+	{
+		Phases.Last().Seconds = FPlatformTime::Seconds() - PhaseStartTime;
+		bInPhase = false;
+	}
+}
+
+void FDocGenRunReport::AddEnumerator(FString const& Name, double PrepassSeconds)
+{
+	FEnumeratorTiming Timing;
+	Timing.Name = Name;
+	Timing.PrepassSeconds = PrepassSeconds;
+	Enumerators.Add(MoveTemp(Timing));
+}
+
+void FDocGenRunReport::BeginEnumerator()
+{
+	++CurrentEnumerator;
+}
+
+void FDocGenRunReport::AddObject(double Seconds, int32 InNumNodes)
+{
+	if(Enumerators.IsValidIndex(CurrentEnumerator))
+	{
+		auto& Timing = Enumerators[CurrentEnumerator];
+		Timing.Seconds += Seconds;
+		++Timing.NumObjects;
+		Timing.NumNodes += InNumNodes;
+	}
+}
+
+void FDocGenRunReport::AddNode(FString const& ClassId, FString const& NodeId, double Seconds)
+{
+	ClassSeconds.FindOrAdd(ClassId) += Seconds;
+
+	auto const IsFaster = [](FNodeTiming const& A, FNodeTiming const& B)
+	{
+		return A.Seconds < B.Seconds;
+	};
+
+	if(SlowestNodes.Num() < NumSlowest)
+	{
+		SlowestNodes.HeapPush(FNodeTiming{ ClassId, NodeId, Seconds }, IsFaster);
+	}
+	else if(SlowestNodes.Num() > 0 && Seconds > SlowestNodes.HeapTop().Seconds)
+	{
+		SlowestNodes.HeapPopDiscard(IsFaster, false);
+		SlowestNodes.HeapPush(FNodeTiming{ ClassId, NodeId, Seconds }, IsFaster);
+	}
+}
+
+TArray< FDocGenRunReport::FNodeTiming > FDocGenRunReport::GetSlowestNodes() const
+{
+	TArray< FNodeTiming > Slowest = SlowestNodes;
+	Slowest.Sort([](FNodeTiming const& A, FNodeTiming const& B)
+	{
+		return A.Seconds > B.Seconds;
+	});
+	Slowest.SetNum(FMath::Min(Slowest.Num(), NumSlowest));
+	return Slowest;
+}
+
+TArray< TPair< FString, double > > FDocGenRunReport::GetSlowestClasses() const
+{
+	TArray< TPair< FString, double > > Slowest = ClassSeconds.Array();
+	Slowest.Sort([](TPair< FString, double > const& A, TPair< FString, double > const& B)
+	{
+		return A.Value > B.Value;
+	});
+	Slowest.SetNum(FMath::Min(Slowest.Num(), NumSlowest));
+	return Slowest;
+}
+
+bool FDocGenRunReport::Save(FString const& Path) const
+{
+	FString Contents;
+	auto Writer = TJsonWriterFactory<>::Create(&Contents);
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("version"), ReportVersion);
+	Writer->WriteValue(TEXT("title"), Title);
+	Writer->WriteValue(TEXT("engine_version"), FEngineVersion::Current().ToString());
+	Writer->WriteValue(TEXT("date"), FDateTime::UtcNow().ToIso8601());
+	Writer->WriteValue(TEXT("result"), Result);
+	Writer->WriteValue(TEXT("total_seconds"), TotalSeconds);
+
+	Writer->WriteObjectStart(TEXT("counts"));
+	Writer->WriteValue(TEXT("nodes"), NumNodes);
+	Writer->WriteValue(TEXT("reused_nodes"), NumReusedNodes);
+	Writer->WriteValue(TEXT("classes"), NumClasses);
+	Writer->WriteValue(TEXT("skipped_assets"), NumSkippedAssets);
+	Writer->WriteValue(TEXT("excluded"), NumExcluded);
+	Writer->WriteValue(TEXT("images_encoded"), NumImagesEncoded);
+	Writer->WriteValue(TEXT("images_reused"), NumImagesReused);
+	Writer->WriteObjectEnd();
+
+	Writer->WriteValue(TEXT("nodes_per_second"), TotalSeconds > 0.0 ? NumNodes / TotalSeconds : 0.0);
+
+	Writer->WriteArrayStart(TEXT("phases"));
+	for(auto const& Phase : Phases)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Phase.Name);
+		Writer->WriteValue(TEXT("seconds"), Phase.Seconds);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteObjectStart(TEXT("seconds"));
+	Writer->WriteValue(TEXT("game_thread_enumerate_wait"), EnumerateWaitSeconds);
+	Writer->WriteValue(TEXT("game_thread_spawn_wait"), SpawnWaitSeconds);
+	Writer->WriteValue(TEXT("node_images"), NodeImageSeconds);
+	Writer->WriteValue(TEXT("node_docs"), NodeDocsSeconds);
+	Writer->WriteValue(TEXT("png_encode"), ImageEncodeSeconds);
+	Writer->WriteObjectEnd();
+
+	Writer->WriteObjectStart(TEXT("bytes_written"));
+	Writer->WriteValue(TEXT("xml"), XmlBytes);
+	Writer->WriteValue(TEXT("images"), ImageBytes);
+	Writer->WriteValue(TEXT("html"), HtmlBytes);
+	Writer->WriteObjectEnd();
+
+	Writer->WriteArrayStart(TEXT("enumerators"));
+	for(auto const& Timing : Enumerators)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Timing.Name);
+		Writer->WriteValue(TEXT("prepass_seconds"), Timing.PrepassSeconds);
+		Writer->WriteValue(TEXT("seconds"), Timing.Seconds);
+		Writer->WriteValue(TEXT("objects"), Timing.NumObjects);
+		Writer->WriteValue(TEXT("nodes"), Timing.NumNodes);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteArrayStart(TEXT("slowest_nodes"));
+	for(auto const& Timing : GetSlowestNodes())
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("class"), Timing.ClassId);
+		Writer->WriteValue(TEXT("id"), Timing.NodeId);
+		Writer->WriteValue(TEXT("seconds"), Timing.Seconds);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteArrayStart(TEXT("slowest_classes"));
+	for(auto const& Entry : GetSlowestClasses())
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("class"), Entry.Key);
+		Writer->WriteValue(TEXT("seconds"), Entry.Value);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	return FFileHelper::SaveStringToFile(Contents, *Path);
+}
+
+void FDocGenRunReport::LogSummary() const
+{
+	UE_LOG(LogKantanDocGen, Display, TEXT("Doc gen run '%s': %s in %.2fs, %i nodes (%i reused) across %i classes, %.1f nodes/s."),
+		*Title,
+		*Result,
+		TotalSeconds,
+		NumNodes,
+		NumReusedNodes,
+		NumClasses,
+		TotalSeconds > 0.0 ? NumNodes / TotalSeconds : 0.0
+	);
+
+	for(auto const& Phase : Phases)
+	{
+		UE_LOG(LogKantanDocGen, Display, TEXT("  %-12s %8.2fs"), *Phase.Name, Phase.Seconds);
+	}
+
+	UE_LOG(LogKantanDocGen, Display, TEXT("  Game thread wait: %.2fs enumerating, %.2fs spawning. Node images %.2fs, node docs %.2fs, image encode %.2fs."),
+		EnumerateWaitSeconds,
+		SpawnWaitSeconds,
+		NodeImageSeconds,
+		NodeDocsSeconds,
+		ImageEncodeSeconds
+	);
+	UE_LOG(LogKantanDocGen, Display, TEXT("  Written: %.1fKB xml, %.1fKB images, %.1fKB html."),
+		XmlBytes / 1024.0,
+		ImageBytes / 1024.0,
+		HtmlBytes / 1024.0
+	);
+
+	for(auto const& Timing : Enumerators)
+	{
+		UE_LOG(LogKantanDocGen, Display, TEXT("  Enumerator '%s': %i objects, %i nodes in %.2fs (prepass %.2fs)."),
+			*Timing.Name,
+			Timing.NumObjects,
+			Timing.NumNodes,
+			Timing.Seconds,
+			Timing.PrepassSeconds
+		);
+	}
+
+	auto const SlowestNodes = GetSlowestNodes();
+	if(SlowestNodes.Num() > 0)
+	{
+		UE_LOG(LogKantanDocGen, Display, TEXT("  Slowest node: '%s' in '%s', %.1fms."), *SlowestNodes[0].NodeId, *SlowestNodes[0].ClassId, SlowestNodes[0].Seconds * 1000.0);
+	}
+
+	auto const SlowestClasses = GetSlowestClasses();
+	if(SlowestClasses.Num() > 0)
+	{
+		UE_LOG(LogKantanDocGen, Display, TEXT("  Slowest class: '%s', %.2fs."), *SlowestClasses[0].Key, SlowestClasses[0].Value);
+	}
+}
+
+
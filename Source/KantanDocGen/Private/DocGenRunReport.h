@@ -0,0 +1,101 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/*
+Timings and counters for a single doc gen run, written out as json so that performance can be compared between runs.
+Not thread safe, filled in by the doc gen worker (or on the game thread while the worker waits on it).
+*/
+class FDocGenRunReport
+{
+public:
+	struct FPhase
+	{
+		FString Name;
+		double Seconds = 0.0;
+	};
+
+	struct FEnumeratorTiming
+	{
+		FString Name;
+		double PrepassSeconds = 0.0;
+		double Seconds = 0.0;			// Enumerating and documenting, excluding the prepass
+		int32 NumObjects = 0;
+		int32 NumNodes = 0;
+	};
+
+	struct FNodeTiming
+	{
+		FString ClassId;
+		FString NodeId;
+		double Seconds = 0.0;
+	};
+
+public:
+	/** Ends the current phase, if any, and starts timing a new one */
+	void BeginPhase(FString const& Name);
+	void EndPhase();
+
+	void AddEnumerator(FString const& Name, double PrepassSeconds);
+	/** Time and nodes are attributed to the enumerator that was most recently begun */
+	void BeginEnumerator();
+	void AddObject(double Seconds, int32 NumNodes);
+
+	void AddNode(FString const& ClassId, FString const& NodeId, double Seconds);
+
+	bool Save(FString const& Path) const;
+	void LogSummary() const;
+
+protected:
+	TArray< FNodeTiming > GetSlowestNodes() const;
+	TArray< TPair< FString, double > > GetSlowestClasses() const;
+
+public:
+	FString Title;
+	FString Result;
+	double TotalSeconds = 0.0;
+
+	int32 NumNodes = 0;
+	int32 NumReusedNodes = 0;
+	int32 NumClasses = 0;
+	int32 NumSkippedAssets = 0;
+	int32 NumExcluded = 0;
+
+	// Time the worker spent blocked on the game thread, enumerating objects and spawning nodes
+	double EnumerateWaitSeconds = 0.0;
+	double SpawnWaitSeconds = 0.0;
+
+	double NodeImageSeconds = 0.0;
+	double NodeDocsSeconds = 0.0;
+	double ImageEncodeSeconds = 0.0;	// Summed across pool threads
+	int32 NumImagesEncoded = 0;
+	int32 NumImagesReused = 0;
+
+	int64 XmlBytes = 0;
+	int64 ImageBytes = 0;
+	int64 HtmlBytes = 0;
+
+	// Number of entries in the slowest nodes and classes lists
+	int32 NumSlowest = 10;
+
+protected:
+	TArray< FPhase > Phases;
+	double PhaseStartTime = 0.0;
+	bool bInPhase = false;
+
+	TArray< FEnumeratorTiming > Enumerators;
+	int32 CurrentEnumerator = INDEX_NONE;
+
+	// Min-heap on time of the NumSlowest slowest nodes so far, so memory doesn't grow with the number of nodes
+	TArray< FNodeTiming > SlowestNodes;
+	TMap< FString, double > ClassSeconds;
+};
+
+
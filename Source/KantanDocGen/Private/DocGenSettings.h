@@ -15,6 +15,16 @@
 #include "DocGenSettings.generated.h"
 
 
+UENUM()
+enum class EDocGenImageFormat: uint8
+{
+	/** Renders the node widget exactly as it appears in the editor. Requires a renderer. */
+	Png,
+	/** Vector approximation of the node, generated without a renderer. */
+	Svg,
+};
+
+
 USTRUCT()
 struct FKantanDocGenSettings
 {
@@ -33,13 +43,13 @@ public:
 	//TArray< FName > ContentPaths;
 	TArray< FDirectoryPath > ContentPaths;
 
-	/** Names of specific classes/blueprints to document. */
+	/** Names of specific classes/blueprints to document. Native class names, or object paths of blueprints or their generated classes. */
 	UPROPERTY()//EditAnywhere, Category = "Class Search")
 	TArray< FName > SpecificClasses;
 
-	/** Names of specific classes/blueprints to exclude. */
-	UPROPERTY()//EditAnywhere, Category = "Class Search")
-	TArray< FName > ExcludedClasses;
+	/** Classes/blueprints to exclude. Entries can be exact names, wildcard patterns or 'regex:<expression>'. Entries containing a '/' match package paths (eg. '/Game/Tests/*'), others match class, blueprint or module names. */
+	UPROPERTY(EditAnywhere, Category = "Class Search")
+	TArray< FString > ExcludedClasses;
 
 	UPROPERTY(EditAnywhere, Category = "Output")
 	FDirectoryPath OutputDirectory;
@@ -50,11 +60,61 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Output")
 	bool bCleanOutputDirectory;
 
+	/** Render an image of each node. Disabling this allows docs to be generated without a renderer (eg. on build machines with -nullrhi). */
+	UPROPERTY(EditAnywhere, Category = "Output")
+	bool bGenerateImages;
+
+	/** Png images are captured from the editor's node widgets, so need Slate rendering. Svg images are laid out directly, and are much faster to generate. */
+	UPROPERTY(EditAnywhere, Category = "Output", Meta = (EditCondition = "bGenerateImages"))
+	EDocGenImageFormat ImageFormat;
+
+	/** Only regenerate docs for nodes, classes and indexes whose content has changed since the last run. Cleaning the output directory forces a full rebuild. */
+	UPROPERTY(EditAnywhere, Category = "Output")
+	bool bIncrementalBuild;
+
+	/** Convert intermediate xml to html with the external KantanDocGen tool (Windows only) rather than the built-in renderer. */
+	UPROPERTY(EditAnywhere, Category = "Output", AdvancedDisplay)
+	bool bUseLegacyConversionTool;
+
+	/** Maximum number of nodes spawned per game thread round trip. Larger batches mean fewer worker stalls, but longer game thread hitches. */
+	UPROPERTY(EditAnywhere, Category = "Performance", AdvancedDisplay, Meta = (ClampMin = 1, UIMin = 1, UIMax = 256))
+	int32 NodeSpawnBatchSize;
+
+	/** Maximum time per editor frame to spend on doc gen work that has to run on the game thread. At least one unit of work is always done per frame. */
+	UPROPERTY(EditAnywhere, Category = "Performance", AdvancedDisplay, Meta = (ClampMin = 0.0, UIMin = 0.5, UIMax = 50.0, Units = "ms"))
+	float GameThreadFrameBudgetMs;
+
+	/** Maximum number of node images being encoded and written in the background at once. Zero means one per worker thread. */
+	UPROPERTY(EditAnywhere, Category = "Performance", AdvancedDisplay, Meta = (ClampMin = 0, UIMin = 0, UIMax = 64))
+	int32 MaxPendingImageWrites;
+
+	/** Number of upcoming blueprints to load asynchronously while the current one is being documented. Zero loads each blueprint only when it's needed. */
+	UPROPERTY(EditAnywhere, Category = "Performance", AdvancedDisplay, Meta = (ClampMin = 0, UIMin = 0, UIMax = 64))
+	int32 AssetPrefetchCount;
+
+	/** Limit on the total on-disk size of blueprint packages being prefetched at once. */
+	UPROPERTY(EditAnywhere, Category = "Performance", AdvancedDisplay, Meta = (ClampMin = 1, UIMin = 1, UIMax = 4096, Units = "Megabytes"))
+	int32 AssetPrefetchBudgetMB;
+
+	/** Number of nodes to spawn between garbage collections, which free the nodes already documented. Zero leaves it to the editor's own collections. */
+	UPROPERTY(EditAnywhere, Category = "Performance", AdvancedDisplay, Meta = (ClampMin = 0, UIMin = 0, UIMax = 100000))
+	int32 GarbageCollectionInterval;
+
 public:
 	FKantanDocGenSettings()
 	{
 		BlueprintContextClass = AActor::StaticClass();
 		bCleanOutputDirectory = false;
+		bGenerateImages = true;
+		ImageFormat = EDocGenImageFormat::Png;
+		bUseLegacyConversionTool = false;
+		bIncrementalBuild = true;
+		NodeSpawnBatchSize = 16;
+		GameThreadFrameBudgetMs = 5.0f;
+		MaxPendingImageWrites = 0;
+		AssetPrefetchCount = 8;
+		AssetPrefetchBudgetMB = 256;
+		GarbageCollectionInterval = 5000;
 	}
 
 	bool HasAnySources() const
@@ -91,19 +151,24 @@ public:
 
 	static void InitDefaults(UKantanDocGenSettingsObject* CDO)
 	{
-		if(CDO->Settings.DocumentationTitle.IsEmpty())
+		InitDefaults(CDO->Settings);
+	}
+
+	static void InitDefaults(FKantanDocGenSettings& Settings)
+	{
+		if(Settings.DocumentationTitle.IsEmpty())
 		{
-			CDO->Settings.DocumentationTitle = FApp::GetProjectName();
+			Settings.DocumentationTitle = FApp::GetProjectName();
 		}
 
-		if(CDO->Settings.OutputDirectory.Path.IsEmpty())
+		if(Settings.OutputDirectory.Path.IsEmpty())
 		{
-			CDO->Settings.OutputDirectory.Path = FPaths::ProjectSavedDir() / TEXT("KantanDocGen");
+			Settings.OutputDirectory.Path = FPaths::ProjectSavedDir() / TEXT("KantanDocGen");
 		}
 
-		if(CDO->Settings.BlueprintContextClass == nullptr)
+		if(Settings.BlueprintContextClass == nullptr)
 		{
-			CDO->Settings.BlueprintContextClass = AActor::StaticClass();
+			Settings.BlueprintContextClass = AActor::StaticClass();
 		}
 	}
 
@@ -0,0 +1,200 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenSpawnerFilter.h"
+#include "BlueprintNodeSpawner.h"
+#include "BlueprintFunctionNodeSpawner.h"
+#include "BlueprintBoundNodeSpawner.h"
+#include "BlueprintComponentNodeSpawner.h"
+#include "BlueprintEventNodeSpawner.h"
+#include "BlueprintVariableNodeSpawner.h"
+#include "BlueprintDelegateNodeSpawner.h"
+#include "K2Node.h"
+#include "K2Node_DynamicCast.h"
+#include "K2Node_Message.h"
+
+
+const TCHAR* LexToString(EDocGenSpawnerRejection Reason)
+{
+	switch(Reason)
+	{
+		case EDocGenSpawnerRejection::None:				return TEXT("None");
+		case EDocGenSpawnerRejection::SpawnerClass:		return TEXT("SpawnerClass");
+		case EDocGenSpawnerRejection::BlueprintEvent:	return TEXT("BlueprintEvent");
+		case EDocGenSpawnerRejection::NodeClass:		return TEXT("NodeClass");
+		case EDocGenSpawnerRejection::NotK2Node:		return TEXT("NotK2Node");
+		case EDocGenSpawnerRejection::FunctionAccess:	return TEXT("FunctionAccess");
+		case EDocGenSpawnerRejection::FunctionMetadata:	return TEXT("FunctionMetadata");
+		default:										return TEXT("Unknown");
+	}
+}
+
+EDocGenSpawnerRejection FDocGenSpawnerFilter::Check(UBlueprintNodeSpawner* Spawner, bool bIsBlueprint)
+{
+	auto Result = EDocGenSpawnerRejection::None;
+
+	auto& SpawnerClassDecisionMap = SpawnerClassDecisions[bIsBlueprint ? 1 : 0];
+	UClass* const SpawnerClass = Spawner->GetClass();
+	if(auto Cached = SpawnerClassDecisionMap.Find(SpawnerClass))
+	{
+		Result = *Cached;
+	}
+	else
+	{
+		Result = SpawnerClassDecisionMap.Add(SpawnerClass, CheckSpawnerClass(SpawnerClass, bIsBlueprint));
+	}
+
+	// Spawners without a node class build their nodes some other way, so have to be spawned to find out
+	if(Result == EDocGenSpawnerRejection::None && Spawner->NodeClass)
+	{
+		if(auto Cached = NodeClassDecisions.Find(Spawner->NodeClass))
+		{
+			Result = *Cached;
+		}
+		else
+		{
+			Result = NodeClassDecisions.Add(Spawner->NodeClass, CheckNodeClass(Spawner->NodeClass));
+		}
+	}
+
+	if(Result == EDocGenSpawnerRejection::None)
+	{
+		if(auto FuncSpawner = Cast< UBlueprintFunctionNodeSpawner >(Spawner))
+		{
+			Result = CheckFunction(FuncSpawner->GetFunction());
+		}
+	}
+
+	if(Result == EDocGenSpawnerRejection::None)
+	{
+		++NumAccepted;
+	}
+	else
+	{
+		++NumRejected[(int32)Result];
+	}
+
+	return Result;
+}
+
+int32 FDocGenSpawnerFilter::GetNumRejected() const
+{
+	int32 Total = 0;
+	for(int32 Count : NumRejected)
+	{
+		Total += Count;
+	}
+	return Total;
+}
+
+FString FDocGenSpawnerFilter::GetRejectionSummary() const
+{
+	TArray< FString > Parts;
+	for(int32 Idx = 0; Idx < (int32)EDocGenSpawnerRejection::Num; ++Idx)
+	{
+		if(NumRejected[Idx] > 0)
+		{
+			Parts.Add(FString::Printf(TEXT("%i %s"), NumRejected[Idx], LexToString((EDocGenSpawnerRejection)Idx)));
+		}
+	}
+	return FString::Join(Parts, TEXT(", "));
+}
+
+EDocGenSpawnerRejection FDocGenSpawnerFilter::CheckSpawnerClass(UClass* SpawnerClass, bool bIsBlueprint)
+{
+	// Spawners of or deriving from the following classes will be excluded
+	static const TSubclassOf< UBlueprintNodeSpawner > ExcludedSpawnerClasses[] = {
+		UBlueprintVariableNodeSpawner::StaticClass(),
+		UBlueprintDelegateNodeSpawner::StaticClass(),
+		UBlueprintBoundNodeSpawner::StaticClass(),
+		UBlueprintComponentNodeSpawner::StaticClass(),
+	};
+
+	// Spawners of or deriving from the following classes will be excluded in a blueprint context
+	static const TSubclassOf< UBlueprintNodeSpawner > BlueprintOnlyExcludedSpawnerClasses[] = {
+		UBlueprintEventNodeSpawner::StaticClass(),
+	};
+
+	for(auto ExclSpawnerClass : ExcludedSpawnerClasses)
+	{
+		if(SpawnerClass->IsChildOf(ExclSpawnerClass))
+		{
+			return EDocGenSpawnerRejection::SpawnerClass;
+		}
+	}
+
+	if(bIsBlueprint)
+	{
+		for(auto ExclSpawnerClass : BlueprintOnlyExcludedSpawnerClasses)
+		{
+			if(SpawnerClass->IsChildOf(ExclSpawnerClass))
+			{
+				return EDocGenSpawnerRejection::BlueprintEvent;
+			}
+		}
+	}
+
+	return EDocGenSpawnerRejection::None;
+}
+
+EDocGenSpawnerRejection FDocGenSpawnerFilter::CheckNodeClass(UClass* NodeClass)
+{
+	// Spawners for nodes of these types (or their subclasses) will be excluded
+	static const TSubclassOf< UK2Node > ExcludedNodeClasses[] = {
+		UK2Node_DynamicCast::StaticClass(),
+		UK2Node_Message::StaticClass(),
+	};
+
+	// Currently Blueprint nodes only
+	if(!NodeClass->IsChildOf< UK2Node >())
+	{
+		return EDocGenSpawnerRejection::NotK2Node;
+	}
+
+	for(auto ExclNodeClass : ExcludedNodeClasses)
+	{
+		if(NodeClass->IsChildOf(ExclNodeClass))
+		{
+			return EDocGenSpawnerRejection::NodeClass;
+		}
+	}
+
+	return EDocGenSpawnerRejection::None;
+}
+
+EDocGenSpawnerRejection FDocGenSpawnerFilter::CheckFunction(UFunction const* Func)
+{
+	// Function spawners for functions with any of the following metadata tags will also be excluded
+	static const FName ExcludedFunctionMeta[] = {
+		TEXT("BlueprintAutocast")
+	};
+
+	static const uint32 PermittedAccessSpecifiers = (FUNC_Public | FUNC_Protected);
+
+	if(Func == nullptr)
+	{
+		return EDocGenSpawnerRejection::None;
+	}
+
+	// @NOTE: We exclude based on access level, but only if this is not a spawner for a blueprint event
+	// (custom events do not have any access specifiers)
+	if((Func->FunctionFlags & FUNC_BlueprintEvent) == 0 && (Func->FunctionFlags & PermittedAccessSpecifiers) == 0)
+	{
+		return EDocGenSpawnerRejection::FunctionAccess;
+	}
+
+	for(auto const& Meta : ExcludedFunctionMeta)
+	{
+		if(Func->HasMetaData(Meta))
+		{
+			return EDocGenSpawnerRejection::FunctionMetadata;
+		}
+	}
+
+	return EDocGenSpawnerRejection::None;
+}
+
+
@@ -0,0 +1,66 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+class UClass;
+class UFunction;
+class UBlueprintNodeSpawner;
+
+/** Why a spawner's nodes aren't documented */
+enum class EDocGenSpawnerRejection: uint8
+{
+	None,
+	SpawnerClass,		// Variable, delegate, bound and component spawners
+	BlueprintEvent,		// Event spawners, when documenting a blueprint
+	NodeClass,			// Casts and messages
+	NotK2Node,
+	FunctionAccess,		// Private functions
+	FunctionMetadata,	// eg. Autocasts
+
+	Num
+};
+
+const TCHAR* LexToString(EDocGenSpawnerRejection Reason);
+
+/*
+Decides which spawners to document before any nodes are spawned.
+Decisions that depend only on the spawner or node class are cached, leaving just the function checks to do per spawner.
+Not thread safe, intended for use on the game thread while enumerating.
+*/
+class FDocGenSpawnerFilter
+{
+public:
+	EDocGenSpawnerRejection Check(UBlueprintNodeSpawner* Spawner, bool bIsBlueprint);
+	bool IsDocumentable(UBlueprintNodeSpawner* Spawner, bool bIsBlueprint)
+	{
+		return Check(Spawner, bIsBlueprint) == EDocGenSpawnerRejection::None;
+	}
+
+	int32 GetNumAccepted() const { return NumAccepted; }
+	int32 GetNumRejected(EDocGenSpawnerRejection Reason) const { return NumRejected[(int32)Reason]; }
+	int32 GetNumRejected() const;
+	/** eg. '12 SpawnerClass, 3 FunctionAccess' */
+	FString GetRejectionSummary() const;
+
+protected:
+	static EDocGenSpawnerRejection CheckSpawnerClass(UClass* SpawnerClass, bool bIsBlueprint);
+	static EDocGenSpawnerRejection CheckNodeClass(UClass* NodeClass);
+	static EDocGenSpawnerRejection CheckFunction(UFunction const* Func);
+
+protected:
+	// Indexed by bIsBlueprint
+	TMap< UClass*, EDocGenSpawnerRejection > SpawnerClassDecisions[2];
+	TMap< UClass*, EDocGenSpawnerRejection > NodeClassDecisions;
+
+	int32 NumAccepted = 0;
+	int32 NumRejected[(int32)EDocGenSpawnerRejection::Num] = {};
+};
+
+
@@ -6,51 +6,233 @@
 
 #include "DocGenTaskProcessor.h"
 #include "KantanDocGenLog.h"
+#include "KantanDocGenStats.h"
+#include "KantanDocGenTrace.h"
 #include "NodeDocsGenerator.h"
+#include "DocGenRunReport.h"
 #include "BlueprintActionDatabase.h"
 #include "BlueprintNodeSpawner.h"
 #include "K2Node.h"
-#include "Async/TaskGraphInterfaces.h"
 #include "Enumeration/ISourceObjectEnumerator.h"
 #include "Enumeration/NativeModuleEnumerator.h"
 #include "Enumeration/ContentPathEnumerator.h"
-#include "Enumeration/CompositeEnumerator.h"
+#include "Enumeration/ClassListEnumerator.h"
+#include "Output/DocGenHtmlRenderer.h"
 #include "Widgets/Notifications/SNotificationList.h"
 #include "Framework/Notifications/NotificationManager.h"
+#include "Framework/Application/SlateApplication.h"
 #include "ThreadingHelpers.h"
+#include "GameThreadScheduler.h"
 #include "Interfaces/IPluginManager.h"
 #include "HAL/FileManager.h"
 #include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeExit.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/Timespan.h"
+#include "Async/ParallelFor.h"
 
 
 #define LOCTEXT_NAMESPACE "KantanDocGen"
 
 
+namespace
+{
+	const TCHAR* LexToString(EDocGenResult Result)
+	{
+		switch(Result)
+		{
+			case EDocGenResult::Success:			return TEXT("Success");
+			case EDocGenResult::NoNodes:			return TEXT("NoNodes");
+			case EDocGenResult::GenerationFailed:	return TEXT("GenerationFailed");
+			case EDocGenResult::ConversionFailed:	return TEXT("ConversionFailed");
+			default:								return TEXT("Cancelled");
+		}
+	}
+
+	// A node spawned on the game thread, handed back to the worker along with its processing state
+	struct FSpawnedNode
+	{
+		UK2Node* Node;
+		FNodeDocsGenerator::FNodeProcessingState State;
+	};
+}
+
+
+FText FDocGenTaskStatus::GetProgressText() const
+{
+	if(bCancelRequested)
+	{
+		return LOCTEXT("DocGenCancelling", "Cancelling doc gen");
+	}
+	if(bConverting)
+	{
+		return LOCTEXT("DocConversionInProgress", "Converting docs");
+	}
+
+	int64 const Start = StartCycles.GetValue();
+	if(Start == 0)
+	{
+		return LOCTEXT("DocGenWaiting", "Doc gen waiting");
+	}
+
+	double const Elapsed = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+	float const Fraction = ProgressPermille.GetValue() / 1000.0f;
+	int32 const Nodes = NumNodes.GetValue();
+
+	FFormatNamedArguments Args;
+	Args.Add(TEXT("Percent"), FText::AsPercent(Fraction));
+	Args.Add(TEXT("Nodes"), FText::AsNumber(Nodes));
+	Args.Add(TEXT("Rate"), FText::AsNumber(FMath::RoundToInt(Elapsed > 0.0 ? Nodes / Elapsed : 0.0)));
+
+	// Too early to extrapolate from
+	if(Fraction < 0.01f || Elapsed < 1.0)
+	{
+		return FText::Format(LOCTEXT("DocGenProgressNoEta", "Doc gen {Percent}\n{Nodes} nodes, {Rate}/s"), Args);
+	}
+
+	Args.Add(TEXT("Remaining"), FText::AsTimespan(FTimespan::FromSeconds(Elapsed * (1.0 - Fraction) / Fraction)));
+	return FText::Format(LOCTEXT("DocGenProgress", "Doc gen {Percent}\n{Nodes} nodes, {Rate}/s, {Remaining} left"), Args);
+}
+
+
 FDocGenTaskProcessor::FDocGenTaskProcessor()
 {
+	NumCompleted = 0;
+	NumCoalesced = 0;
+	WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
 	bRunning = false;
 	bTerminationRequest = false;
 }
 
-void FDocGenTaskProcessor::QueueTask(FKantanDocGenSettings const& Settings)
+FDocGenTaskProcessor::~FDocGenTaskProcessor()
+{
+	ShutdownWorker();
+
+	FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+	WorkEvent = nullptr;
+}
+
+void FDocGenTaskProcessor::StartWorker(EThreadPriority Priority)
+{
+	if(Thread.IsValid())
+	{
+		return;
+	}
+
+	bTerminationRequest = false;
+	Thread.Reset(FRunnableThread::Create(this, TEXT("KantanDocGenProcessorThread"), 0, Priority));
+}
+
+void FDocGenTaskProcessor::ShutdownWorker()
+{
+	if(!Thread.IsValid())
+	{
+		return;
+	}
+
+	Stop();
+
+	// A running task may be waiting on the game thread, so keep its work going until it has wound up
+	while(bRunning)
+	{
+		FDocGenGameThreadScheduler::Get().Flush();
+		FPlatformProcess::Sleep(0.001f);
+	}
+
+	Thread->WaitForCompletion();
+	Thread.Reset();
+}
+
+bool FDocGenTaskProcessor::CanCoalesce(FDocGenTask const& Task, FKantanDocGenSettings const& Settings, FDocGenTaskOptions const& Options) const
+{
+	return !Task.Status->bCancelRequested
+		&& Task.Options.IntermediateDir == Options.IntermediateDir
+		&& Task.Options.bIntermediateOnly == Options.bIntermediateOnly
+		&& FKantanDocGenSettings::StaticStruct()->CompareScriptStruct(&Task.Settings, &Settings, PPF_None)
+		;
+}
+
+void FDocGenTaskProcessor::QueueTask(FKantanDocGenSettings const& Settings, FDocGenTaskOptions Options)
 {
-	TSharedPtr< FDocGenTask > NewTask = MakeShared< FDocGenTask >();
+	{
+		FScopeLock Lock(&QueueCS);
+		for(auto const& Task : Waiting)
+		{
+			if(CanCoalesce(*Task, Settings, Options))
+			{
+				UE_LOG(LogKantanDocGen, Log, TEXT("Doc gen request for '%s' is identical to one already waiting, coalescing."), *Settings.DocumentationTitle);
+				Task->CoalescedOnComplete.Add(MoveTemp(Options.OnComplete));
+				++NumCoalesced;
+				return;
+			}
+		}
+	}
+
+	FDocGenTaskPtr NewTask = MakeShared< FDocGenTask, ESPMode::ThreadSafe >();
 	NewTask->Settings = Settings;
+	NewTask->Options = MoveTemp(Options);
+
+	if(FSlateApplication::IsInitialized())
+	{
+		FNotificationInfo Info(LOCTEXT("DocGenWaiting", "Doc gen waiting"));
+		Info.Image = nullptr;//FEditorStyle::GetBrush(TEXT("LevelEditor.RecompileGameCode"));
+		Info.FadeInDuration = 0.2f;
+		Info.ExpireDuration = 5.0f;
+		Info.FadeOutDuration = 1.0f;
+		Info.bUseThrobber = true;
+		Info.bUseSuccessFailIcons = true;
+		Info.bUseLargeFont = true;
+		Info.bFireAndForget = false;
+		Info.bAllowThrottleWhenFrameRateIsLow = false;
+
+		// The status outlives the notification's hold on it, and is safe to touch from either thread
+		TSharedRef< FDocGenTaskStatus, ESPMode::ThreadSafe > Status = NewTask->Status;
+		Info.ButtonDetails.Add(FNotificationButtonInfo(
+			LOCTEXT("DocGenCancel", "Cancel"),
+			LOCTEXT("DocGenCancelTooltip", "Stop generating docs, and discard any partially written output"),
+			FSimpleDelegate::CreateLambda([Status] { Status->bCancelRequested = true; }),
+			SNotificationItem::CS_Pending
+		));
+
+		NewTask->Notification = FSlateNotificationManager::Get().AddNotification(Info);
+		NewTask->Notification->SetText(TAttribute< FText >::Create(TAttribute< FText >::FGetter::CreateLambda([Status]
+		{
+			return Status->GetProgressText();
+		})));
+		NewTask->Notification->SetCompletionState(SNotificationItem::CS_Pending);
+	}
+
+	{
+		FScopeLock Lock(&QueueCS);
+		Waiting.Add(NewTask);
+	}
+	WorkEvent->Trigger();
+}
+
+FDocGenQueueStatus FDocGenTaskProcessor::GetQueueStatus() const
+{
+	FScopeLock Lock(&QueueCS);
+
+	FDocGenQueueStatus Status;
+	Status.bWorkerRunning = bRunning;
+	if(Active.IsValid())
+	{
+		Status.ActiveTitle = Active->Settings.DocumentationTitle;
+		Status.ActiveProgressPermille = Active->Status->ProgressPermille.GetValue();
+	}
+	for(auto const& Task : Waiting)
+	{
+		Status.WaitingTitles.Add(Task->Settings.DocumentationTitle);
+	}
+	Status.NumCompleted = NumCompleted;
+	Status.NumCoalesced = NumCoalesced;
+	return Status;
+}
 
-	FNotificationInfo Info(LOCTEXT("DocGenWaiting", "Doc gen waiting"));
-	Info.Image = nullptr;//FEditorStyle::GetBrush(TEXT("LevelEditor.RecompileGameCode"));
-	Info.FadeInDuration = 0.2f;
-	Info.ExpireDuration = 5.0f;
-	Info.FadeOutDuration = 1.0f;
-	Info.bUseThrobber = true;
-	Info.bUseSuccessFailIcons = true;
-	Info.bUseLargeFont = true;
-	Info.bFireAndForget = false;
-	Info.bAllowThrottleWhenFrameRateIsLow = false;
-	NewTask->Notification = FSlateNotificationManager::Get().AddNotification(Info);
-	NewTask->Notification->SetCompletionState(SNotificationItem::CS_Pending);
-
-	Waiting.Enqueue(NewTask);
+FString FDocGenTaskProcessor::GetDefaultIntermediateDir(FKantanDocGenSettings const& Settings)
+{
+	return FPaths::ProjectIntermediateDir() / TEXT("KantanDocGen") / Settings.DocumentationTitle;
 }
 
 bool FDocGenTaskProcessor::IsRunning() const
@@ -66,10 +248,62 @@ bool FDocGenTaskProcessor::Init()
 
 uint32 FDocGenTaskProcessor::Run()
 {
-	TSharedPtr< FDocGenTask > Next;
-	while(!bTerminationRequest && Waiting.Dequeue(Next))
+	while(!bTerminationRequest)
 	{
+		FDocGenTaskPtr Next;
+		{
+			FScopeLock Lock(&QueueCS);
+			if(Waiting.Num() > 0)
+			{
+				Next = Waiting[0];
+				Waiting.RemoveAt(0);
+				Active = Next;
+			}
+		}
+
+		if(!Next.IsValid())
+		{
+			WorkEvent->Wait();
+			continue;
+		}
+
 		ProcessTask(Next);
+
+		FScopeLock Lock(&QueueCS);
+		Active.Reset();
+		++NumCompleted;
+	}
+
+	// Tasks still queued will never run, but whoever requested them may be waiting on them
+	TArray< FDocGenTaskPtr > Abandoned;
+	{
+		FScopeLock Lock(&QueueCS);
+		Abandoned = MoveTemp(Waiting);
+		Waiting.Reset();
+	}
+
+	for(auto const& Task : Abandoned)
+	{
+		UE_LOG(LogKantanDocGen, Display, TEXT("Doc gen '%s' cancelled before it started."), *Task->Settings.DocumentationTitle);
+
+		// Don't wait on the game thread, which may itself be waiting for this thread to finish
+		DocGenThreads::EnqueueOnGameThread([Task]
+			{
+				if(auto Notification = Task->Notification)
+				{
+					Notification->SetText(LOCTEXT("DocGenCancelled", "Doc gen cancelled"));
+					Notification->SetCompletionState(SNotificationItem::CS_Fail);
+					Notification->ExpireAndFadeout();
+				}
+			});
+
+		FDocGenTaskResult Result;
+		Result.Result = EDocGenResult::Cancelled;
+		Task->Options.OnComplete.ExecuteIfBound(Result);
+		for(auto const& OnComplete : Task->CoalescedOnComplete)
+		{
+			OnComplete.ExecuteIfBound(Result);
+		}
 	}
 
 	return 0;
@@ -83,89 +317,338 @@ void FDocGenTaskProcessor::Exit()
 void FDocGenTaskProcessor::Stop()
 {
 	bTerminationRequest = true;
+	WorkEvent->Trigger();
+}
+
+bool FDocGenTaskProcessor::IsCancelRequested() const
+{
+	return bTerminationRequest || (Current.IsValid() && Current->Task->Status->bCancelRequested);
+}
+
+void FDocGenTaskProcessor::UpdateProgress()
+{
+	// Objects are enumerated ahead of being documented, so go by the enumerator's progress as of the current object
+	float Done = (float)Current->CompletedEstimatedObjects;
+	if(Current->CurrentEnumerator.IsValid())
+	{
+		Done += Current->CurrentObject.EnumeratorProgress * Current->CurrentEnumerator->EstimatedSize();
+	}
+
+	float const Fraction = Current->TotalEstimatedObjects > 0 ? FMath::Clamp(Done / Current->TotalEstimatedObjects, 0.0f, 1.0f) : 0.0f;
+	Current->Task->Status->ProgressPermille.Set(FMath::RoundToInt(Fraction * 1000.0f));
+}
+
+void FDocGenTaskProcessor::DiscardPartialOutput()
+{
+	// Nothing may still be writing into the directories once they're gone
+	if(Current->Renderer.IsValid())
+	{
+		Current->Renderer->WaitForPendingRenders();
+	}
+	if(Current->DocGen.IsValid())
+	{
+		Current->DocGen->FlushImageWrites();
+	}
+
+	for(auto const& Dir : Current->DiscardOnCancel)
+	{
+		UE_LOG(LogKantanDocGen, Log, TEXT("Discarding partial output in '%s'."), *Dir);
+		IFileManager::Get().DeleteDirectory(*Dir, false, true);
+	}
+}
+
+void FDocGenTaskProcessor::FGameThreadHopStats::AddSample(double Time, int32 Items)
+{
+	++NumHops;
+	NumItems += Items;
+	TotalTime += Time;
+	MaxTime = FMath::Max(MaxTime, Time);
+}
+
+void FDocGenTaskProcessor::ProcessTask(FDocGenTaskPtr InTask)
+{
+	KANTANDOCGEN_TRACE_SCOPE("Task");
+
+	double const StartTime = FPlatformTime::Seconds();
+
+	FDocGenTaskResult Result;
+	FDocGenRunReport Report;
+	ProcessTask(InTask, Result, Report);
+	Result.TotalTime = FPlatformTime::Seconds() - StartTime;
+
+	if(Result.Result == EDocGenResult::Cancelled)
+	{
+		UE_LOG(LogKantanDocGen, Display, TEXT("Doc gen cancelled."));
+		DiscardPartialOutput();
+		NotifyFailure(LOCTEXT("DocGenCancelled", "Doc gen cancelled"));
+	}
+
+	FillReport(Report, Result);
+	Report.LogSummary();
+
+	// Next to the html output, or the intermediate docs if there isn't any
+	auto const& Settings = InTask->Settings;
+	auto const& Options = InTask->Options;
+	FString const ReportPath = Options.bIntermediateOnly ?
+		(Options.IntermediateDir.IsEmpty() ? GetDefaultIntermediateDir(Settings) : Options.IntermediateDir) / TEXT("report.json") :
+		Settings.OutputDirectory.Path / Settings.DocumentationTitle + TEXT("_report.json");
+	if(!Report.Save(ReportPath))
+	{
+		UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to write doc gen report to '%s'."), *ReportPath);
+	}
+
+	Current.Reset();
+
+	InTask->Options.OnComplete.ExecuteIfBound(Result);
+	for(auto const& OnComplete : InTask->CoalescedOnComplete)
+	{
+		OnComplete.ExecuteIfBound(Result);
+	}
+}
+
+void FDocGenTaskProcessor::FillReport(FDocGenRunReport& Report, FDocGenTaskResult const& Result) const
+{
+	Report.EndPhase();
+
+	Report.Title = Current->Task->Settings.DocumentationTitle;
+	Report.Result = LexToString(Result.Result);
+	Report.TotalSeconds = Result.TotalTime;
+	Report.NumNodes = Result.NumNodes;
+	Report.NumReusedNodes = Result.NumReusedNodes;
+	Report.NumClasses = Result.NumClasses;
+	Report.NumSkippedAssets = Result.NumSkippedAssets;
+	Report.NumExcluded = Result.NumExcluded;
+
+	if(Current->DocGen.IsValid())
+	{
+		auto const Stats = Current->DocGen->GetStats();
+		Report.NodeImageSeconds = Stats.NodeImageTime;
+		Report.NodeDocsSeconds = Stats.NodeDocsTime;
+		Report.ImageEncodeSeconds = Stats.ImageEncodeTime;
+		Report.NumImagesEncoded = Stats.NumImagesEncoded;
+		Report.NumImagesReused = Stats.NumImagesReused;
+		Report.ImageBytes = Stats.ImageBytes;
+		Report.XmlBytes = Stats.XmlBytes;
+	}
+
+	if(Current->Renderer.IsValid())
+	{
+		Report.HtmlBytes = Current->Renderer->GetBytesWritten();
+	}
+}
+
+void FDocGenTaskProcessor::NotifyFailure(FText const& Msg)
+{
+	DocGenThreads::RunOnGameThread([this, Msg]
+		{
+			if(auto Notification = Current->Task->Notification)
+			{
+				Notification->SetText(Msg);
+				Notification->SetCompletionState(SNotificationItem::CS_Fail);
+				Notification->ExpireAndFadeout();
+			}
+		});
+	//GEditor->PlayEditorSound(CompileSuccessSound);
 }
 
-void FDocGenTaskProcessor::ProcessTask(TSharedPtr< FDocGenTask > InTask)
+void FDocGenTaskProcessor::ProcessTask(FDocGenTaskPtr InTask, FDocGenTaskResult& OutResult, FDocGenRunReport& Report)
 {
 	/********** Lambdas for the game thread to execute **********/
 	
-	auto GameThread_InitDocGen = [this](FString const& DocTitle, FString const& IntermediateDir) -> bool
+	auto GameThread_InitDocGen = [this](FString const& DocTitle, FString const& IntermediateDir, bool const& bIncremental) -> bool
 	{
-		Current->Task->Notification->SetExpireDuration(2.0f);
-		Current->Task->Notification->SetText(LOCTEXT("DocGenInProgress", "Doc gen in progress"));
+		// Text is bound to the task status, so follows progress by itself
+		if(auto Notification = Current->Task->Notification)
+		{
+			Notification->SetExpireDuration(2.0f);
+		}
 
-		return Current->DocGen->GT_Init(DocTitle, IntermediateDir, Current->Task->Settings.BlueprintContextClass);
+		auto const& Settings = Current->Task->Settings;
+		return Current->DocGen->GT_Init(DocTitle, IntermediateDir, Settings.BlueprintContextClass, bIncremental, Settings.bGenerateImages, Settings.ImageFormat);
 	};
 
-	TFunction<void()> GameThread_EnqueueEnumerators = [this]()
+	// An enumerator whose prepass has been begun on the game thread
+	struct FPendingPrepass
 	{
-		// @TODO: Specific class enumerator
-		Current->Enumerators.Enqueue(MakeShared< FCompositeEnumerator< FNativeModuleEnumerator > >(Current->Task->Settings.NativeModules));
+		FString Name;
+		TSharedPtr< ISourceObjectEnumerator > Enumerator;
+		double Seconds;
+	};
+
+	// Everything in the prepasses that touches UObjects or the asset registry, for all sources in a single step.
+	// Exclusions, filtering and sorting are left for FinishPrepass, so that they can run in parallel off the game thread.
+	auto GameThread_BeginPrepasses = [this](TArray< FPendingPrepass >& OutPrepasses)
+	{
+		KANTANDOCGEN_TRACE_SCOPE("Prepass");
+
+		auto const& Settings = Current->Task->Settings;
+		FDocGenExclusionFilter const Exclusions(Settings.ExcludedClasses);
+
+		if(Settings.SpecificClasses.Num() > 0)
+		{
+			// Resolving the names is all UObject work, so this one is done entirely here
+			double const PrepassStartTime = FPlatformTime::Seconds();
+			auto ClassEnumerator = MakeShared< FClassListEnumerator >(Settings.SpecificClasses, Exclusions);
+			OutPrepasses.Add(FPendingPrepass{ TEXT("Specific classes"), ClassEnumerator, FPlatformTime::Seconds() - PrepassStartTime });
+		}
+
+		for(auto const& Module : Settings.NativeModules)
+		{
+			double const PrepassStartTime = FPlatformTime::Seconds();
+			auto ModuleEnumerator = FNativeModuleEnumerator::GT_BeginPrepass(Module, Exclusions);
+			OutPrepasses.Add(FPendingPrepass{ TEXT("Module ") + Module.ToString(), ModuleEnumerator, FPlatformTime::Seconds() - PrepassStartTime });
+		}
 
 		TArray< FName > ContentPackagePaths;
-		for (auto const& Path : Current->Task->Settings.ContentPaths)
+		for (auto const& Path : Settings.ContentPaths)
 		{
 			ContentPackagePaths.AddUnique(FName(*Path.Path));
 		}
-		Current->Enumerators.Enqueue(MakeShared< FCompositeEnumerator< FContentPathEnumerator > >(ContentPackagePaths));
+
+		if(ContentPackagePaths.Num() == 0)
+		{
+			return;
+		}
+
+		FContentPrefetchOptions Prefetch;
+		Prefetch.MaxAssets = Settings.AssetPrefetchCount;
+		Prefetch.MaxBytes = (int64)Settings.AssetPrefetchBudgetMB * 1024 * 1024;
+
+		double const PrepassStartTime = FPlatformTime::Seconds();
+		auto ContentEnumerator = FContentPathEnumerator::GT_BeginPrepass(ContentPackagePaths, Prefetch);
+		OutPrepasses.Add(FPendingPrepass{ TEXT("Content paths"), ContentEnumerator, FPlatformTime::Seconds() - PrepassStartTime });
 	};
 
-	auto GameThread_EnumerateNextObject = [this]() -> bool
+	auto EnqueueEnumerators = [this, GameThread_BeginPrepasses]()
 	{
-		Current->SourceObject.Reset();
-		Current->CurrentSpawners.Empty();
+		TArray< FPendingPrepass > Prepasses;
+		DocGenThreads::RunOnGameThread([&] { GameThread_BeginPrepasses(Prepasses); });
 
-		while(auto Obj = Current->CurrentEnumerator->GetNext())
+		{
+			KANTANDOCGEN_TRACE_SCOPE("FinishPrepass");
+
+			auto const& ExcludedClasses = Current->Task->Settings.ExcludedClasses;
+			ParallelFor(Prepasses.Num(), [&](int32 Idx)
+			{
+				// Compiled regex patterns can't be shared between threads, so each prepass gets its own filter
+				FDocGenExclusionFilter const Exclusions(ExcludedClasses);
+
+				double const StartTime = FPlatformTime::Seconds();
+				Prepasses[Idx].Enumerator->FinishPrepass(Exclusions);
+				Prepasses[Idx].Seconds += FPlatformTime::Seconds() - StartTime;
+			});
+		}
+
+		// In the original order, for consistent output
+		for(auto const& Prepass : Prepasses)
+		{
+			Current->Report->AddEnumerator(Prepass.Name, Prepass.Seconds);
+
+			Current->NumSkippedAssets += Prepass.Enumerator->GetNumSkipped();
+			Current->NumExcludedObjects += Prepass.Enumerator->GetNumExcluded();
+			Current->TotalEstimatedObjects += Prepass.Enumerator->EstimatedSize();
+			Current->Enumerators.Enqueue(Prepass.Enumerator);
+		}
+	};
+
+	// Snapshots the documentable spawners of as many source objects as fit in the frame budget. Objects that have to be loaded
+	// are taken one at a time though, so that the enumerator's prefetching overlaps their loading with documenting the previous one.
+	auto GameThread_EnumerateNextObjects = [this](TArray< FSourceObjectRecord >& OutRecords) -> bool
+	{
+		KANTANDOCGEN_TRACE_SCOPE("Enumerate");
+
+		OutRecords.Reset();
+
+		auto& Enumerator = *Current->CurrentEnumerator;
+		bool const bSingleObject = Enumerator.LoadsObjects();
+		double const EndTime = FPlatformTime::Seconds() + Current->Task->Settings.GameThreadFrameBudgetMs / 1000.0;
+		auto const& BPActionMap = FBlueprintActionDatabase::Get().GetAllActions();
+
+		while(auto Obj = Enumerator.GetNext())
 		{
 			// Ignore if already processed
 			if(Current->Processed.Contains(Obj))
 			{
 				continue;
 			}
+			Current->Processed.Add(Obj);
 
-			// Cache list of spawners for this object
-			auto& BPActionMap = FBlueprintActionDatabase::Get().GetAllActions();
-			if(auto ActionList = BPActionMap.Find(Obj))
+			auto ActionList = BPActionMap.Find(Obj);
+			if(ActionList == nullptr || ActionList->Num() == 0)
 			{
-				if(ActionList->Num() == 0)
-				{
-					continue;
-				}
+				continue;
+			}
 
-				Current->SourceObject = Obj;
-				for(auto Spawner : *ActionList)
+			// Only keep what will be documented, so rejected spawners cost nothing more on either thread
+			FSourceObjectRecord Record;
+			bool const bIsBlueprint = Obj->IsA< UBlueprint >();
+			for(auto Spawner : *ActionList)
+			{
+				if(Current->SpawnerFilter.IsDocumentable(Spawner, bIsBlueprint))
 				{
-					// Add to queue as weak ptr
-					check(Current->CurrentSpawners.Enqueue(Spawner));
+					Record.Spawners.Add(Spawner);
 				}
+			}
+
+			// Nothing to document, don't bother the worker with it
+			if(Record.Spawners.Num() == 0)
+			{
+				continue;
+			}
 
-				// Done
-				Current->Processed.Add(Obj);
-				return true;
+			Record.Object = Obj;
+			Record.EnumeratorProgress = Enumerator.EstimateProgress();
+			OutRecords.Add(MoveTemp(Record));
+
+			if(bSingleObject || FPlatformTime::Seconds() >= EndTime)
+			{
+				break;
 			}
 		}
 
-		// This enumerator is finished
-		return false;
+		// Empty means this enumerator is finished
+		return OutRecords.Num() > 0;
+	};
+
+	// Nodes are only rooted while the worker is using them, after which they're taken out of the graph to be freed by the next GC
+	auto GameThread_ReleaseNodes = [this](TArray< FSpawnedNode >& Batch)
+	{
+		KANTANDOCGEN_TRACE_SCOPE("ReleaseNodes");
+
+		for(auto const& Spawned : Batch)
+		{
+			Spawned.Node->RemoveFromRoot();
+			Current->DocGen->GT_RemoveNode(Spawned.Node);
+		}
+		Batch.Reset();
 	};
 
-	auto GameThread_EnumerateNextNode = [this](FNodeDocsGenerator::FNodeProcessingState& OutState) -> UK2Node*
+	// Releases the previous batch first, to avoid a separate game thread hop
+	auto GameThread_EnumerateNextNodeBatch = [this, GameThread_ReleaseNodes](TArray< FSpawnedNode >& OutBatch) -> bool
 	{
+		KANTANDOCGEN_TRACE_SCOPE("SpawnNodes");
+
+		GameThread_ReleaseNodes(OutBatch);
+
 		// We've just come in from another thread, check the source object is still around
-		if(!Current->SourceObject.IsValid())
+		auto& Record = Current->CurrentObject;
+		if(!Record.Object.IsValid())
 		{
 			UE_LOG(LogKantanDocGen, Warning, TEXT("Object being enumerated expired!"));
-			return nullptr;
+			return false;
 		}
 
-		// Try to grab the next spawner in the cached list
-		TWeakObjectPtr< UBlueprintNodeSpawner > Spawner;
-		while(Current->CurrentSpawners.Dequeue(Spawner))
+		int32 const MaxBatchSize = FMath::Max(Current->Task->Settings.NodeSpawnBatchSize, 1);
+
+		// Keep grabbing spawners from the snapshot until the batch is full
+		while(OutBatch.Num() < MaxBatchSize && Current->NextSpawnerIndex < Record.Spawners.Num())
 		{
+			auto const& Spawner = Record.Spawners[Current->NextSpawnerIndex++];
 			if(Spawner.IsValid())
 			{
 				// See if we can document this spawner
-				auto K2_NodeInst = Current->DocGen->GT_InitializeForSpawner(Spawner.Get(), Current->SourceObject.Get(), OutState);
+				FNodeDocsGenerator::FNodeProcessingState NodeState;
+				auto K2_NodeInst = Current->DocGen->GT_InitializeForSpawner(Spawner.Get(), Record.Object.Get(), NodeState);
 
 				if(K2_NodeInst == nullptr)
 				{
@@ -174,24 +657,41 @@ void FDocGenTaskProcessor::ProcessTask(TSharedPtr< FDocGenTask > InTask)
 
 				// Make sure this node object will never be GCd until we're done with it.
 				K2_NodeInst->AddToRoot();
-				return K2_NodeInst;
+				OutBatch.Add(FSpawnedNode{ K2_NodeInst, MoveTemp(NodeState) });
 			}
 		}
 
-		// No spawners left in the queue
-		return nullptr;
+		// Empty batch means no spawners left in the queue
+		return OutBatch.Num() > 0;
+	};
+
+	// Once a source object is done, the full docs for its nodes are no longer needed, so get their pages written and free them.
+	// Only the compact node summaries are kept for the class and index documents.
+	auto FlushNodeDocs = [this](TSet< FDocGenClassEntryPtr > const& Classes)
+	{
+		KANTANDOCGEN_TRACE_SCOPE("FlushNodeDocs");
+
+		for(auto const& ClassDoc : Classes)
+		{
+			TArray< FDocGenNodeEntry > NodeDocs = MoveTemp(ClassDoc->NodeDocs);
+			ClassDoc->NodeDocs.Reset();
+
+			if(Current->Renderer.IsValid() && NodeDocs.Num() > 0)
+			{
+				Current->Renderer->RenderNodesAsync(ClassDoc, MoveTemp(NodeDocs));
+			}
+		}
 	};
 
 	auto GameThread_FinalizeDocs = [this](FString const& OutputPath) -> bool
 	{
+		KANTANDOCGEN_TRACE_SCOPE("Finalize");
+
 		bool const Result = Current->DocGen->GT_Finalize(OutputPath);
 
 		if (!Result)
 		{
-			Current->Task->Notification->SetText(LOCTEXT("DocFinalizationFailed", "Doc gen failed"));
-			Current->Task->Notification->SetCompletionState(SNotificationItem::CS_Fail);
-			Current->Task->Notification->ExpireAndFadeout();
-			//GEditor->PlayEditorSound(CompileSuccessSound);
+			NotifyFailure(LOCTEXT("DocFinalizationFailed", "Doc gen failed"));
 		}
 
 		return Result;
@@ -202,97 +702,342 @@ void FDocGenTaskProcessor::ProcessTask(TSharedPtr< FDocGenTask > InTask)
 
 	Current = MakeUnique< FDocGenCurrentTask >();
 	Current->Task = InTask;
+	Current->Report = &Report;
 
-	FString IntermediateDir = FPaths::ProjectIntermediateDir() / TEXT("KantanDocGen") / Current->Task->Settings.DocumentationTitle;
+	// May have been cancelled while waiting
+	if(IsCancelRequested())
+	{
+		OutResult.Result = EDocGenResult::Cancelled;
+		return;
+	}
+	Current->Task->Status->StartCycles.Set((int64)FPlatformTime::Cycles64());
 
-	DocGenThreads::RunOnGameThread(GameThread_EnqueueEnumerators);	
+	Report.BeginPhase(TEXT("Setup"));
 
-	// Initialize the doc generator
-	Current->DocGen = MakeUnique< FNodeDocsGenerator >();
+	auto& Scheduler = FDocGenGameThreadScheduler::Get();
+	Scheduler.SetFrameBudget(Current->Task->Settings.GameThreadFrameBudgetMs);
+	Scheduler.ConsumeStats();
+
+	ON_SCOPE_EXIT
+	{
+		auto const FrameStats = Scheduler.ConsumeStats();
+		UE_LOG(LogKantanDocGen, Log, TEXT("Game thread impact: %i work items over %i frames (budget %.1fms). Per frame: avg %.2fms, max %.2fms, %i frames over budget. %.1f%% of frame time spent on doc gen."),
+			FrameStats.NumItems,
+			FrameStats.NumFrames,
+			Scheduler.GetFrameBudget(),
+			FrameStats.NumFrames > 0 ? FrameStats.TotalWorkTime * 1000.0 / FrameStats.NumFrames : 0.0,
+			FrameStats.MaxFrameWorkTime * 1000.0,
+			FrameStats.NumOverBudgetFrames,
+			FrameStats.TotalFrameTime > 0.0 ? FrameStats.TotalWorkTime * 100.0 / FrameStats.TotalFrameTime : 0.0
+		);
+	};
+
+	auto const& Options = Current->Task->Options;
+	FString const IntermediateDir = Options.IntermediateDir.IsEmpty() ? GetDefaultIntermediateDir(Current->Task->Settings) : Options.IntermediateDir;
 
-	if(!DocGenThreads::RunOnGameThreadRetVal(GameThread_InitDocGen, Current->Task->Settings.DocumentationTitle, IntermediateDir))
+	EnqueueEnumerators();
+
+	// Initialize the doc generator
+	Current->DocGen = MakeUnique< FNodeDocsGenerator >(Current->Task->Settings.MaxPendingImageWrites);
+
+	// Reuse docs from previous runs where possible. The built-in renderer only re-renders what has changed,
+	// so that also requires the previous output to still be there.
+	auto const& Settings = Current->Task->Settings;
+	bool const bRenderHtml = !Options.bIntermediateOnly && !Settings.bUseLegacyConversionTool;
+	bool const bIncremental = Settings.bIncrementalBuild && (
+		!bRenderHtml
+		|| (!Settings.bCleanOutputDirectory && FPaths::FileExists(Settings.OutputDirectory.Path / Settings.DocumentationTitle / TEXT("index.html")))
+		);
+
+	if(!DocGenThreads::RunOnGameThreadRetVal(GameThread_InitDocGen, Current->Task->Settings.DocumentationTitle, IntermediateDir, bIncremental))
 	{
 		UE_LOG(LogKantanDocGen, Error, TEXT("Failed to initialize doc generator!"));
+		OutResult.Result = EDocGenResult::GenerationFailed;
 		return;
 	}
 
-	bool const bCleanIntermediate = true;
+	bool const bCleanIntermediate = !bIncremental;
 	if(bCleanIntermediate)
 	{
 		IFileManager::Get().DeleteDirectory(*IntermediateDir, false, true);
+		Current->DiscardOnCancel.Add(IntermediateDir);
 	}
 
-	for(auto const& Name : Current->Task->Settings.ExcludedClasses)
+	// Partial output in a directory that was previously good is left for the next run to bring up to date,
+	// since no manifest will be saved for it
+	FString const OutputDocsDir = Settings.OutputDirectory.Path / Settings.DocumentationTitle;
+	if(!Options.bIntermediateOnly && (Settings.bCleanOutputDirectory || !IFileManager::Get().DirectoryExists(*OutputDocsDir)))
 	{
-		Current->Excluded.Add(Name);
+		Current->DiscardOnCancel.Add(OutputDocsDir);
 	}
 
+	if(bRenderHtml)
+	{
+		Current->Renderer = CreateHtmlRenderer(
+			IntermediateDir,
+			Settings.OutputDirectory.Path,
+			Settings.DocumentationTitle,
+			Settings.bCleanOutputDirectory
+		);
+		if(!Current->Renderer.IsValid())
+		{
+			UE_LOG(LogKantanDocGen, Error, TEXT("Failed to prepare output directory!"));
+			NotifyFailure(LOCTEXT("DocOutputFailed", "Doc gen failed - Could not write output"));
+			OutResult.Result = EDocGenResult::ConversionFailed;
+			return;
+		}
+	}
+
+	Report.BeginPhase(TEXT("Generation"));
+
 	int SuccessfulNodeCount = 0;
+	int ReusedNodeCount = 0;
 	while(Current->Enumerators.Dequeue(Current->CurrentEnumerator))
 	{
-		while(DocGenThreads::RunOnGameThreadRetVal(GameThread_EnumerateNextObject))	// Game thread: Enumerate next Obj, get spawner list for Obj, store as array of weak ptrs.
+		Report.BeginEnumerator();
+
+		TArray< FSourceObjectRecord > Records;
+		int32 NextRecordIndex = 0;
+		while(true)
 		{
-			if(bTerminationRequest)
+			if(IsCancelRequested())
 			{
+				OutResult.Result = EDocGenResult::Cancelled;
 				return;
 			}
 
-			FNodeDocsGenerator::FNodeProcessingState NodeState;
-			while(auto NodeInst = DocGenThreads::RunOnGameThreadRetVal(GameThread_EnumerateNextNode, NodeState))	// Game thread: Get next still valid spawner, spawn node, add to root, return it)
+			double const ObjectStartTime = FPlatformTime::Seconds();
+
+			// Game thread: Enumerate the next objects, and snapshot their spawners as weak ptrs. Only needed once the last snapshot is used up.
+			if(NextRecordIndex >= Records.Num())
 			{
-				// NodeInst should hopefully not reference anything except stuff we control (ie graph object), and it's rooted so should be safe to deal with here
+				bool const bGotObjects = DocGenThreads::RunOnGameThreadRetVal(GameThread_EnumerateNextObjects, Records);
+				double const HopTime = FPlatformTime::Seconds() - ObjectStartTime;
+				Current->EnumerateHopStats.AddSample(HopTime, Records.Num());
+				Report.EnumerateWaitSeconds += HopTime;
+				NextRecordIndex = 0;
 
-				// Generate image
-				if(!Current->DocGen->GenerateNodeImage(NodeInst, NodeState))
+				if(!bGotObjects)
 				{
-					UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to generate node image!"))
-					continue;
+					Current->CompletedEstimatedObjects += Current->CurrentEnumerator->EstimatedSize();
+					Current->CurrentEnumerator.Reset();
+					Current->CurrentObject = FSourceObjectRecord();
+					UpdateProgress();
+					break;
 				}
+			}
+
+			Current->CurrentObject = MoveTemp(Records[NextRecordIndex++]);
+			Current->NextSpawnerIndex = 0;
+
+			int32 const ObjectStartNodeCount = SuccessfulNodeCount;
 
-				// Generate doc
-				if(!Current->DocGen->GenerateNodeDocs(NodeInst, NodeState))
+			TArray< FSpawnedNode > NodeBatch;
+			TSet< FDocGenClassEntryPtr > TouchedClasses;
+			while(true)
+			{
+				// Game thread: Release the previous batch, get up to a batch worth of still valid spawners, spawn nodes, add to root, return them
+				double const HopStartTime = FPlatformTime::Seconds();
+				bool const bGotNodes = DocGenThreads::RunOnGameThreadRetVal(GameThread_EnumerateNextNodeBatch, NodeBatch);
+				double const HopTime = FPlatformTime::Seconds() - HopStartTime;
+
+				Current->SpawnHopStats.AddSample(HopTime, NodeBatch.Num());
+				Report.SpawnWaitSeconds += HopTime;
+				SET_FLOAT_STAT(STAT_KantanDocGen_SpawnHopLatency, HopTime * 1000.0);
+				SET_DWORD_STAT(STAT_KantanDocGen_NodesPerSpawnHop, NodeBatch.Num());
+				TRACE_COUNTER_SET(KantanDocGen_NodesInFlight, NodeBatch.Num());
+
+				if(!bGotNodes)
 				{
-					UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to generate node doc xml!"))
-					continue;
+					break;
+				}
+
+				for(auto& Spawned : NodeBatch)
+				{
+					TRACE_COUNTER_DECREMENT(KantanDocGen_NodesInFlight);
+					TouchedClasses.Add(Spawned.State.ClassDoc);
+
+					// Node should hopefully not reference anything except stuff we control (ie graph object), and it's rooted so should be safe to deal with here
+
+					// Nothing to do if nothing has changed since the last run
+					if(Spawned.State.bUpToDate)
+					{
+						Current->DocGen->ReuseNodeDocs(Spawned.State);
+						++SuccessfulNodeCount;
+						++ReusedNodeCount;
+						continue;
+					}
+
+					double const NodeStartTime = FPlatformTime::Seconds();
+
+					// Generate image
+					if(Settings.bGenerateImages && !Current->DocGen->GenerateNodeImage(Spawned.Node, Spawned.State))
+					{
+						UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to generate node image!"))
+						continue;
+					}
+
+					// Generate doc
+					if(!Current->DocGen->GenerateNodeDocs(Spawned.Node, Spawned.State))
+					{
+						UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to generate node doc xml!"))
+						continue;
+					}
+
+					Report.AddNode(Spawned.State.ClassDoc->Id, Spawned.State.NodeId, FPlatformTime::Seconds() - NodeStartTime);
+					++SuccessfulNodeCount;
+				}
+
+				Current->Task->Status->NumNodes.Set(SuccessfulNodeCount);
+
+				// Classes with many nodes can take a while, don't wait for the end of one to cancel
+				if(IsCancelRequested())
+				{
+					break;
 				}
+			}
 
-				++SuccessfulNodeCount;
+			// Only left over if cancelled part way through the object
+			if(NodeBatch.Num() > 0)
+			{
+				DocGenThreads::RunOnGameThread([&] { GameThread_ReleaseNodes(NodeBatch); });
+			}
+
+			FlushNodeDocs(TouchedClasses);
+
+			Report.AddObject(FPlatformTime::Seconds() - ObjectStartTime, SuccessfulNodeCount - ObjectStartNodeCount);
+			UpdateProgress();
+
+			// Between objects, nothing spawned is still in use. Blueprints that get collected along the way are just reloaded if needed again.
+			int32 const GCInterval = Settings.GarbageCollectionInterval;
+			if(GCInterval > 0 && Current->SpawnHopStats.NumItems - Current->SpawnedAtLastGarbageCollection >= GCInterval)
+			{
+				DocGenThreads::RunOnGameThread([]
+				{
+					KANTANDOCGEN_TRACE_SCOPE("CollectGarbage");
+					CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+				});
+				Current->SpawnedAtLastGarbageCollection = Current->SpawnHopStats.NumItems;
+				++Current->NumGarbageCollections;
 			}
 		}
 	}
 
+	UE_LOG(LogKantanDocGen, Log, TEXT("Documented %i nodes, %i of which were unchanged since the last run."), SuccessfulNodeCount, ReusedNodeCount);
+	OutResult.NumNodes = SuccessfulNodeCount;
+	OutResult.NumReusedNodes = ReusedNodeCount;
+	OutResult.NumSkippedAssets = Current->NumSkippedAssets;
+	OutResult.NumExcluded = Current->NumExcludedObjects;
+	if(Current->NumExcludedObjects > 0)
+	{
+		UE_LOG(LogKantanDocGen, Log, TEXT("Excluded %i classes and blueprints."), Current->NumExcludedObjects);
+	}
+	if(Current->NumSkippedAssets > 0)
+	{
+		UE_LOG(LogKantanDocGen, Log, TEXT("Skipped loading %i blueprints with nothing to document."), Current->NumSkippedAssets);
+	}
+
+	{
+		auto const& HopStats = Current->SpawnHopStats;
+		UE_LOG(LogKantanDocGen, Log, TEXT("Spawned %i nodes in %i game thread hops (batch size %i). Hop latency: avg %.2fms, max %.2fms."),
+			HopStats.NumItems,
+			HopStats.NumHops,
+			Current->Task->Settings.NodeSpawnBatchSize,
+			HopStats.NumHops > 0 ? HopStats.TotalTime * 1000.0 / HopStats.NumHops : 0.0,
+			HopStats.MaxTime * 1000.0
+		);
+		auto const& EnumStats = Current->EnumerateHopStats;
+		UE_LOG(LogKantanDocGen, Log, TEXT("Enumerated %i objects in %i game thread hops. Hop latency: avg %.2fms, max %.2fms."),
+			EnumStats.NumItems,
+			EnumStats.NumHops,
+			EnumStats.NumHops > 0 ? EnumStats.TotalTime * 1000.0 / EnumStats.NumHops : 0.0,
+			EnumStats.MaxTime * 1000.0
+		);
+
+		auto const& Filter = Current->SpawnerFilter;
+		UE_LOG(LogKantanDocGen, Log, TEXT("Queued %i spawners for documenting, rejected %i (%s)."),
+			Filter.GetNumAccepted(),
+			Filter.GetNumRejected(),
+			*Filter.GetRejectionSummary()
+		);
+		if(Current->NumGarbageCollections > 0)
+		{
+			UE_LOG(LogKantanDocGen, Log, TEXT("Collected garbage %i times (every %i nodes)."), Current->NumGarbageCollections, Settings.GarbageCollectionInterval);
+		}
+	}
+
+	if(IsCancelRequested())
+	{
+		OutResult.Result = EDocGenResult::Cancelled;
+		return;
+	}
+
 	if(SuccessfulNodeCount == 0)
 	{
 		UE_LOG(LogKantanDocGen, Error, TEXT("No nodes were found to document!"));
+		NotifyFailure(LOCTEXT("DocFinalizationFailed", "Doc gen failed - No nodes found"));
+		OutResult.Result = EDocGenResult::NoNodes;
+		return;
+	}
 
-		DocGenThreads::RunOnGameThread([this]
-			{
-				Current->Task->Notification->SetText(LOCTEXT("DocFinalizationFailed", "Doc gen failed - No nodes found"));
-				Current->Task->Notification->SetCompletionState(SNotificationItem::CS_Fail);
-				Current->Task->Notification->ExpireAndFadeout();
-			});
-		//GEditor->PlayEditorSound(CompileSuccessSound);
+	// All node images need to be on disk before finalizing
+	Report.BeginPhase(TEXT("ImageFlush"));
+	bool bImagesWritten = false;
+	{
+		KANTANDOCGEN_TRACE_SCOPE("WaitForImages");
+		bImagesWritten = Current->DocGen->FlushImageWrites();
+	}
+
+	// Fail before the manifest is saved, so the nodes with missing images aren't taken as up to date by the next run
+	if(!bImagesWritten)
+	{
+		UE_LOG(LogKantanDocGen, Error, TEXT("Failed to write node images!"));
+		NotifyFailure(LOCTEXT("DocImagesFailed", "Doc gen failed - Could not write node images"));
+		OutResult.Result = EDocGenResult::GenerationFailed;
 		return;
 	}
 
 	// Game thread: DocGen.GT_Finalize()
+	Report.BeginPhase(TEXT("Finalize"));
 	if(!DocGenThreads::RunOnGameThreadRetVal(GameThread_FinalizeDocs, IntermediateDir))
 	{
 		UE_LOG(LogKantanDocGen, Error, TEXT("Failed to finalize xml docs!"));
+		OutResult.Result = EDocGenResult::GenerationFailed;
 		return;
 	}
+	OutResult.NumClasses = Current->DocGen->GetClassDocs().Num();
 
-	DocGenThreads::RunOnGameThread([this]
-		{
-			Current->Task->Notification->SetText(LOCTEXT("DocConversionInProgress", "Converting docs"));
-		});
+	if(Options.bIntermediateOnly)
+	{
+		Current->DocGen->SaveManifest();
+		OutResult.Result = EDocGenResult::Success;
+		return;
+	}
 
-	auto TransformationResult = ProcessIntermediateDocs(
-		IntermediateDir,
-		Current->Task->Settings.OutputDirectory.Path,
-		Current->Task->Settings.DocumentationTitle,
-		Current->Task->Settings.bCleanOutputDirectory
-	);
+	if(IsCancelRequested())
+	{
+		OutResult.Result = EDocGenResult::Cancelled;
+		return;
+	}
+
+	Current->Task->Status->bConverting = true;
+
+	Report.BeginPhase(TEXT("Conversion"));
+	KANTANDOCGEN_TRACE_SCOPE("Conversion");
+
+	auto TransformationResult = Settings.bUseLegacyConversionTool ?
+		ProcessIntermediateDocs(
+			IntermediateDir,
+			Settings.OutputDirectory.Path,
+			Settings.DocumentationTitle,
+			Settings.bCleanOutputDirectory
+		) :
+		RenderHtmlDocs(*Current->Renderer);
+	if(TransformationResult == EIntermediateProcessingResult::Cancelled)
+	{
+		OutResult.Result = EDocGenResult::Cancelled;
+		return;
+	}
 	if(TransformationResult != EIntermediateProcessingResult::Success)
 	{
 		UE_LOG(LogKantanDocGen, Error, TEXT("Failed to transform xml to html!"));
@@ -300,18 +1045,23 @@ void FDocGenTaskProcessor::ProcessTask(TSharedPtr< FDocGenTask > InTask)
 		auto Msg = FText::Format(LOCTEXT("DocConversionFailed", "Doc gen failed - {0}"),
 			TransformationResult == EIntermediateProcessingResult::DiskWriteFailure ? LOCTEXT("CouldNotWriteToOutput", "Could not write output, please clear output directory or enable 'Clean Output Directory' option") : LOCTEXT("GenericTransformationFailure", "Conversion failure")
 			);
-		DocGenThreads::RunOnGameThread([this, Msg]
-			{
-				Current->Task->Notification->SetText(Msg);
-				Current->Task->Notification->SetCompletionState(SNotificationItem::CS_Fail);
-				Current->Task->Notification->ExpireAndFadeout();
-			});
-		//GEditor->PlayEditorSound(CompileSuccessSound);
+		NotifyFailure(Msg);
+		OutResult.Result = EDocGenResult::ConversionFailed;
 		return;
 	}
 
+	// Only now that output is known to be good can the next run rely on it
+	Current->DocGen->SaveManifest();
+	OutResult.Result = EDocGenResult::Success;
+
 	DocGenThreads::RunOnGameThread([this]
 		{
+			auto Notification = Current->Task->Notification;
+			if(!Notification.IsValid())
+			{
+				return;
+			}
+
 			FString HyperlinkTarget = TEXT("file://") / FPaths::ConvertRelativePathToFull(Current->Task->Settings.OutputDirectory.Path / Current->Task->Settings.DocumentationTitle / TEXT("index.html"));
 			auto OnHyperlinkClicked = [HyperlinkTarget]
 			{
@@ -322,16 +1072,14 @@ void FDocGenTaskProcessor::ProcessTask(TSharedPtr< FDocGenTask > InTask)
 			auto const HyperlinkText = TAttribute< FText >::Create(TAttribute< FText >::FGetter::CreateLambda([] { return LOCTEXT("GeneratedDocsHyperlink", "View docs"); }));
 			// @TODO: Bug in SNotificationItemImpl::SetHyperlink, ignores non-delegate attributes... LOCTEXT("GeneratedDocsHyperlink", "View docs");
 		
-			Current->Task->Notification->SetText(LOCTEXT("DocConversionSuccessful", "Doc gen completed"));
-			Current->Task->Notification->SetCompletionState(SNotificationItem::CS_Success);
-			Current->Task->Notification->SetHyperlink(
+			Notification->SetText(LOCTEXT("DocConversionSuccessful", "Doc gen completed"));
+			Notification->SetCompletionState(SNotificationItem::CS_Success);
+			Notification->SetHyperlink(
 				FSimpleDelegate::CreateLambda(OnHyperlinkClicked),
 				HyperlinkText
 			);
-			Current->Task->Notification->ExpireAndFadeout();
+			Notification->ExpireAndFadeout();
 		});
-
-	Current.Reset();
 }
 
 FDocGenTaskProcessor::EIntermediateProcessingResult FDocGenTaskProcessor::ProcessIntermediateDocs(FString const& IntermediateDir, FString const& OutputDir, FString const& DocTitle, bool bCleanOutput)
@@ -373,6 +1121,7 @@ FDocGenTaskProcessor::EIntermediateProcessingResult FDocGenTaskProcessor::Proces
 	);
 
 	int32 ReturnCode = 0;
+	bool bCancelled = false;
 	if(Proc.IsValid())
 	{
 		FString BufferedText;
@@ -380,12 +1129,14 @@ FDocGenTaskProcessor::EIntermediateProcessingResult FDocGenTaskProcessor::Proces
 		{
 			bProcessFinished = FPlatformProcess::GetProcReturnCode(Proc, &ReturnCode);
 
-			/*			if(!bProcessFinished && Warn->ReceivedUserCancel())
+			if(!bProcessFinished && IsCancelRequested())
 			{
-			FPlatformProcess::TerminateProc(ProcessHandle);
-			bProcessFinished = true;
+				UE_LOG(LogKantanDocGen, Log, TEXT("Terminating conversion tool."));
+				FPlatformProcess::TerminateProc(Proc, true);
+				bProcessFinished = true;
+				bCancelled = true;
 			}
-			*/
+
 			BufferedText += FPlatformProcess::ReadPipe(PipeRead);
 
 			int32 EndOfLineIdx;
@@ -407,7 +1158,7 @@ FDocGenTaskProcessor::EIntermediateProcessingResult FDocGenTaskProcessor::Proces
 		FPlatformProcess::CloseProc(Proc);
 		Proc.Reset();
 
-		if(ReturnCode != 0)
+		if(ReturnCode != 0 && !bCancelled)
 		{
 			UE_LOG(LogKantanDocGen, Error, TEXT("KantanDocGen tool failed (code %i), see above output."), ReturnCode);
 		}
@@ -417,6 +1168,21 @@ FDocGenTaskProcessor::EIntermediateProcessingResult FDocGenTaskProcessor::Proces
 	FPlatformProcess::ClosePipe(0, PipeRead);
 	FPlatformProcess::ClosePipe(0, PipeWrite);
 
+	if(bCancelled)
+	{
+		return EIntermediateProcessingResult::Cancelled;
+	}
+
+	// The tool only knows about per-class content, node images live in a shared directory
+	if(ReturnCode == 0)
+	{
+		FDocGenHtmlRenderer Renderer(DocTitle, IntermediateDir, OutputDir / DocTitle);
+		if(!Renderer.SyncImages(Current->DocGen->GetReferencedImages()))
+		{
+			return EIntermediateProcessingResult::DiskWriteFailure;
+		}
+	}
+
 	switch(ReturnCode)
 	{
 		case 0:
@@ -430,5 +1196,59 @@ FDocGenTaskProcessor::EIntermediateProcessingResult FDocGenTaskProcessor::Proces
 	}
 }
 
+TSharedPtr< FDocGenHtmlRenderer > FDocGenTaskProcessor::CreateHtmlRenderer(FString const& IntermediateDir, FString const& OutputDir, FString const& DocTitle, bool bCleanOutput)
+{
+	const FString StylesheetPath = FDocGenHtmlRenderer::GetDefaultStylesheetPath();
+	if(StylesheetPath.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	auto Renderer = MakeShared< FDocGenHtmlRenderer >(DocTitle, IntermediateDir, OutputDir / DocTitle);
+	if(!Renderer->PrepareOutput(StylesheetPath, bCleanOutput))
+	{
+		return nullptr;
+	}
+
+	return Renderer;
+}
+
+FDocGenTaskProcessor::EIntermediateProcessingResult FDocGenTaskProcessor::RenderHtmlDocs(FDocGenHtmlRenderer& Renderer)
+{
+	double const StartTime = FPlatformTime::Seconds();
+
+	// Node pages were mostly rendered as their source objects completed
+	if(!Renderer.WaitForPendingRenders())
+	{
+		return EIntermediateProcessingResult::DiskWriteFailure;
+	}
+
+	if(IsCancelRequested())
+	{
+		return EIntermediateProcessingResult::Cancelled;
+	}
+
+	TArray< TPair< FString, FString > > StaleNodes;
+	for(auto const& Record : Current->DocGen->GetStaleNodes())
+	{
+		StaleNodes.Emplace(Record.ClassId, Record.NodeId);
+	}
+	Renderer.RemovePages(Current->DocGen->GetStaleClasses(), StaleNodes);
+
+	auto const ClassDocs = Current->DocGen->GetClassDocs();
+	if(!Renderer.RenderAll(ClassDocs, Current->DocGen->IsIndexDirty()))
+	{
+		return EIntermediateProcessingResult::DiskWriteFailure;
+	}
+
+	if(!Renderer.SyncImages(Current->DocGen->GetReferencedImages()))
+	{
+		return EIntermediateProcessingResult::DiskWriteFailure;
+	}
+
+	UE_LOG(LogKantanDocGen, Log, TEXT("Rendered html for %i classes in %.2fs."), ClassDocs.Num(), FPlatformTime::Seconds() - StartTime);
+	return EIntermediateProcessingResult::Success;
+}
+
 
 #undef LOCTEXT_NAMESPACE
@@ -7,9 +7,14 @@
 #pragma once
 
 #include "DocGenSettings.h"
+#include "DocGenSpawnerFilter.h"
 
 #include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/CriticalSection.h"
 #include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSafeCounter64.h"
 #include "UObject/WeakObjectPtrTemplates.h"
 #include "Containers/Queue.h"
 #include "CoreMinimal.h"
@@ -17,17 +22,93 @@
 
 class ISourceObjectEnumerator;
 class FNodeDocsGenerator;
+class FDocGenHtmlRenderer;
+class FDocGenRunReport;
 
 class UBlueprintNodeSpawner;
 
 
+enum class EDocGenResult: uint8
+{
+	Success,
+	NoNodes,			// Nothing found to document
+	GenerationFailed,	// Failed to initialize or finalize docs
+	ConversionFailed,	// Failed to produce html from the intermediate docs
+	Cancelled,
+};
+
+struct FDocGenTaskResult
+{
+	EDocGenResult Result = EDocGenResult::Cancelled;
+	int32 NumNodes = 0;
+	int32 NumReusedNodes = 0;
+	int32 NumClasses = 0;
+	int32 NumSkippedAssets = 0;		// Blueprints which were never loaded, as they had nothing to document
+	int32 NumExcluded = 0;			// Classes and blueprints matching Settings.ExcludedClasses
+	double TotalTime = 0.0;
+};
+
+/** Invoked on the processor thread once a task has finished, whatever the outcome */
+DECLARE_DELEGATE_OneParam(FOnDocGenTaskComplete, FDocGenTaskResult const&);
+
+/** Options for tasks which are not started from the editor UI */
+struct FDocGenTaskOptions
+{
+	FString IntermediateDir;			// Empty for the default location within the project
+	bool bIntermediateOnly = false;		// Stop once intermediate docs are written, without producing html
+	FOnDocGenTaskComplete OnComplete;
+};
+
+
+/**
+Live state of a task, shared with its notification.
+Written by the processor thread and read from the game thread, so the worker never has to wait on the UI to report progress.
+*/
+struct FDocGenTaskStatus
+{
+	FThreadSafeCounter ProgressPermille;	// Estimated fraction of source objects enumerated
+	FThreadSafeCounter NumNodes;
+	FThreadSafeCounter64 StartCycles;		// When generation began, zero before then
+	FThreadSafeBool bConverting = false;
+	FThreadSafeBool bCancelRequested = false;
+
+	FText GetProgressText() const;
+};
+
+
+/** Snapshot of the processor's queue, for display */
+struct FDocGenQueueStatus
+{
+	bool bWorkerRunning = false;
+	FString ActiveTitle;				// Empty when idle
+	int32 ActiveProgressPermille = 0;
+	TArray< FString > WaitingTitles;
+	int32 NumCompleted = 0;
+	int32 NumCoalesced = 0;				// Requests folded into an identical task that was already waiting
+};
+
+
+/*
+Runs doc gen tasks one at a time on a long lived worker thread, which sleeps while there is nothing queued.
+*/
 class FDocGenTaskProcessor: public FRunnable
 {
 public:
 	FDocGenTaskProcessor();
+	~FDocGenTaskProcessor();
 
 public:
-	void QueueTask(FKantanDocGenSettings const& Settings);
+	/** Creates the worker thread, if not already running */
+	void StartWorker(EThreadPriority Priority);
+	/** Cancels any running task and waits for the worker to exit. Game thread only. */
+	void ShutdownWorker();
+
+	/** A task with the same settings and options as one still waiting is folded into it, rather than run twice. */
+	void QueueTask(FKantanDocGenSettings const& Settings, FDocGenTaskOptions Options = FDocGenTaskOptions());
+
+	FDocGenQueueStatus GetQueueStatus() const;
+
+	static FString GetDefaultIntermediateDir(FKantanDocGenSettings const& Settings);
 	bool IsRunning() const;
 
 public:
@@ -40,47 +121,111 @@ protected:
 	struct FDocGenTask
 	{
 		FKantanDocGenSettings Settings;
-		TSharedPtr< class SNotificationItem > Notification;
+		TSharedPtr< class SNotificationItem > Notification;	// Null when running without Slate (commandlet)
+		FDocGenTaskOptions Options;
+		TSharedRef< FDocGenTaskStatus, ESPMode::ThreadSafe > Status = MakeShared< FDocGenTaskStatus, ESPMode::ThreadSafe >();
+		// Completion callbacks of requests coalesced into this one
+		TArray< FOnDocGenTaskComplete > CoalescedOnComplete;
+	};
+
+	// Shared between the game thread and the worker
+	typedef TSharedPtr< FDocGenTask, ESPMode::ThreadSafe > FDocGenTaskPtr;
+
+	struct FGameThreadHopStats
+	{
+		int32 NumHops = 0;
+		int32 NumItems = 0;
+		double TotalTime = 0.0;
+		double MaxTime = 0.0;
+
+		void AddSample(double Time, int32 Items);
+	};
+
+	// A source object and the spawners to document for it, captured on the game thread so that the worker can go through many without returning there
+	struct FSourceObjectRecord
+	{
+		TWeakObjectPtr< UObject > Object;
+		TArray< TWeakObjectPtr< UBlueprintNodeSpawner > > Spawners;
+		float EnumeratorProgress = 0.0f;	// Of the enumerator, as of this object
 	};
 
 	struct FDocGenCurrentTask
 	{
-		TSharedPtr< FDocGenTask > Task;
+		FDocGenTaskPtr Task;
 
 		TQueue< TSharedPtr< ISourceObjectEnumerator > > Enumerators;
-		TSet< FName > Excluded;
 		TSet< TWeakObjectPtr< UObject > > Processed;
 
 		TSharedPtr< ISourceObjectEnumerator > CurrentEnumerator;
-		TWeakObjectPtr< UObject > SourceObject;
-		TQueue< TWeakObjectPtr< UBlueprintNodeSpawner > > CurrentSpawners;
+		FSourceObjectRecord CurrentObject;
+		int32 NextSpawnerIndex = 0;
 
 		TUniquePtr< FNodeDocsGenerator > DocGen;
+		// Game thread only
+		FDocGenSpawnerFilter SpawnerFilter;
+		// Only when using the built-in renderer
+		TSharedPtr< FDocGenHtmlRenderer > Renderer;
+
+		FGameThreadHopStats EnumerateHopStats;
+		FGameThreadHopStats SpawnHopStats;
+		int32 NumGarbageCollections = 0;
+		int32 SpawnedAtLastGarbageCollection = 0;
+		int32 NumSkippedAssets = 0;
+		int32 NumExcludedObjects = 0;
+
+		// For progress, weighted by the estimated size of each enumerator
+		int32 TotalEstimatedObjects = 0;
+		int32 CompletedEstimatedObjects = 0;
+
+		// What to delete if the task is cancelled, only directories this run started from scratch
+		TArray< FString > DiscardOnCancel;
+
+		// Owned by the outer ProcessTask, which writes it out once the task is done
+		FDocGenRunReport* Report = nullptr;
 	};
 
 	struct FDocGenOutputTask
 	{
-		TSharedPtr< FDocGenTask > Task;
+		FDocGenTaskPtr Task;
 	};
 
 protected:
-	void ProcessTask(TSharedPtr< FDocGenTask > InTask);
+	bool CanCoalesce(FDocGenTask const& Task, FKantanDocGenSettings const& Settings, FDocGenTaskOptions const& Options) const;
+	void ProcessTask(FDocGenTaskPtr InTask);
+	void ProcessTask(FDocGenTaskPtr InTask, FDocGenTaskResult& OutResult, FDocGenRunReport& Report);
+	void FillReport(FDocGenRunReport& Report, FDocGenTaskResult const& Result) const;
+	void NotifyFailure(FText const& Msg);
+	bool IsCancelRequested() const;
+	void UpdateProgress();
+	void DiscardPartialOutput();
 
 	enum EIntermediateProcessingResult: uint8 {
 		Success,
 		SuccessWithErrors,
 		UnknownError,
 		DiskWriteFailure,
+		Cancelled,
 	};
 
 	EIntermediateProcessingResult ProcessIntermediateDocs(FString const& IntermediateDir, FString const& OutputDir, FString const& DocTitle, bool bCleanOutput);
+	TSharedPtr< FDocGenHtmlRenderer > CreateHtmlRenderer(FString const& IntermediateDir, FString const& OutputDir, FString const& DocTitle, bool bCleanOutput);
+	EIntermediateProcessingResult RenderHtmlDocs(FDocGenHtmlRenderer& Renderer);
 
 protected:
-	TQueue< TSharedPtr< FDocGenTask > > Waiting;
+	// Guards the waiting list, active task and counts
+	mutable FCriticalSection QueueCS;
+	TArray< FDocGenTaskPtr > Waiting;
+	FDocGenTaskPtr Active;
+	int32 NumCompleted;
+	int32 NumCoalesced;
+
 	TUniquePtr< FDocGenCurrentTask > Current;
 	TQueue< TSharedPtr< FDocGenOutputTask > > Converting;
 
-	FThreadSafeBool bRunning;	// @NOTE: Using this to sync with module calls from game thread is not 100% okay (we're not atomically testing), but whatevs.
+	TUniquePtr< FRunnableThread > Thread;
+	FEvent* WorkEvent;			// Triggered whenever a task is queued, or the worker should exit
+
+	FThreadSafeBool bRunning;
 	FThreadSafeBool bTerminationRequest;
 };
 
@@ -0,0 +1,110 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "ClassListEnumerator.h"
+#include "KantanDocGenLog.h"
+#include "Engine/Blueprint.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+
+FClassListEnumerator::FClassListEnumerator(
+	TArray< FName > const& InClassNames,
+	FDocGenExclusionFilter const& InExclusions
+)
+{
+	CurIndex = 0;
+	NumExcluded = 0;
+
+	Prepass(InClassNames, InExclusions);
+}
+
+UObject* FClassListEnumerator::ResolveClass(FString const& ClassName)
+{
+	// Object paths can be found directly, or loaded if need be
+	if(ClassName.Contains(TEXT("/")))
+	{
+		if(auto Obj = StaticFindObject(UObject::StaticClass(), nullptr, *ClassName))
+		{
+			return Obj;
+		}
+		return StaticLoadObject(UObject::StaticClass(), nullptr, *ClassName, nullptr, LOAD_NoWarn);
+	}
+
+	return FindObject< UClass >(ANY_PACKAGE, *ClassName);
+}
+
+void FClassListEnumerator::Prepass(TArray< FName > const& ClassNames, FDocGenExclusionFilter const& Exclusions)
+{
+	for(auto const& ClassName : ClassNames)
+	{
+		UObject* Obj = ResolveClass(ClassName.ToString());
+
+		// As with the other enumerators, the BP action database is keyed on native classes, or on the blueprint
+		// itself rather than its generated class
+		UObject* ObjectToProcess = nullptr;
+		if(auto Class = Cast< UClass >(Obj))
+		{
+			if(Class->ClassGeneratedBy != nullptr)
+			{
+				ObjectToProcess = Class->ClassGeneratedBy;
+			}
+			else if(Class->HasAllClassFlags(CLASS_Native))
+			{
+				ObjectToProcess = Class;
+			}
+		}
+		else if(Obj && Obj->IsA< UBlueprint >())
+		{
+			ObjectToProcess = Obj;
+		}
+
+		if(ObjectToProcess == nullptr)
+		{
+			UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to find specified class '%s', skipping."), *ClassName.ToString());
+			continue;
+		}
+
+		if(ObjectList.Contains(ObjectToProcess))
+		{
+			continue;
+		}
+
+		// Package paths are '/Script/<Module>' or '/<ContentRoot>/...', either way the first element stands in for the module
+		FString const PkgName = ObjectToProcess->GetOutermost()->GetName();
+		TArray< FString > PathElements;
+		PkgName.ParseIntoArray(PathElements, TEXT("/"), true);
+		FString const ModuleName = PkgName.StartsWith(TEXT("/Script/")) && PathElements.Num() > 1 ? PathElements[1]
+			: PathElements.Num() > 0 ? PathElements[0] : FString();
+
+		if(Exclusions.IsExcluded(ObjectToProcess->GetName(), ModuleName, PkgName))
+		{
+			UE_LOG(LogKantanDocGen, Log, TEXT("Excluding object '%s' in package '%s'"), *ObjectToProcess->GetName(), *PkgName);
+			++NumExcluded;
+			continue;
+		}
+
+		UE_LOG(LogKantanDocGen, Log, TEXT("Enumerating object '%s' in package '%s'"), *ObjectToProcess->GetName(), *PkgName);
+		ObjectList.Add(ObjectToProcess);
+	}
+}
+
+UObject* FClassListEnumerator::GetNext()
+{
+	return CurIndex < ObjectList.Num() ? ObjectList[CurIndex++].Get() : nullptr;
+}
+
+float FClassListEnumerator::EstimateProgress() const
+{
+	return ObjectList.Num() > 0 ? (float)CurIndex / ObjectList.Num() : 1.0f;
+}
+
+int32 FClassListEnumerator::EstimatedSize() const
+{
+	return ObjectList.Num();
+}
+
+
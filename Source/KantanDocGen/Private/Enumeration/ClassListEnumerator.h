@@ -0,0 +1,42 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "ISourceObjectEnumerator.h"
+#include "DocGenExclusionFilter.h"
+
+
+/*
+Enumerates an explicit list of classes, given by name (native classes) or by object path (native or blueprint classes,
+or blueprints themselves). Names are resolved during the prepass; blueprints must already be loaded or loadable.
+*/
+class FClassListEnumerator: public ISourceObjectEnumerator
+{
+public:
+	FClassListEnumerator(
+		TArray< FName > const& InClassNames,
+		FDocGenExclusionFilter const& InExclusions = FDocGenExclusionFilter()
+	);
+
+public:
+	virtual UObject* GetNext() override;
+	virtual float EstimateProgress() const override;
+	virtual int32 EstimatedSize() const override;
+
+	virtual int32 GetNumExcluded() const override { return NumExcluded; }
+
+protected:
+	void Prepass(TArray< FName > const& ClassNames, FDocGenExclusionFilter const& Exclusions);
+	static UObject* ResolveClass(FString const& ClassName);
+
+protected:
+	TArray< TWeakObjectPtr< UObject > > ObjectList;
+	int32 CurIndex;
+	int32 NumExcluded;
+};
+
+
@@ -62,6 +62,18 @@ public:
 		return TotalSize;
 	}
 
+	virtual bool LoadsObjects() const override
+	{
+		for(int32 Idx = CurEnumIndex; Idx < ChildEnumList.Num(); ++Idx)
+		{
+			if(ChildEnumList[Idx]->LoadsObjects())
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
 protected:
 	void Prepass(TArray< FName > const& Names)
 	{
@@ -6,35 +6,198 @@
 
 #include "ContentPathEnumerator.h"
 #include "KantanDocGenLog.h"
+#include "KantanDocGenStats.h"
+#include "KantanDocGenTrace.h"
 #include "AssetRegistryModule.h"
 #include "ARFilter.h"
 #include "Engine/Blueprint.h"
 #include "Animation/AnimBlueprint.h"
+#include "UObject/UObjectGlobals.h"
+#include "HAL/PlatformTime.h"
 
 
 FContentPathEnumerator::FContentPathEnumerator(
-	FName const& InPath
-)
+	TArray< FName > const& InPaths,
+	FDocGenExclusionFilter const& InExclusions,
+	FContentPrefetchOptions const& InPrefetch
+):
+	FContentPathEnumerator(InPrefetch)
+{
+	QueryAssets(InPaths);
+	FinishPrepass(InExclusions);
+}
+
+FContentPathEnumerator::FContentPathEnumerator(FContentPrefetchOptions const& InPrefetch)
 {
 	CurIndex = 0;
+	NumSkipped = 0;
+	NumExcluded = 0;
+	NumPaths = 0;
+	Prefetch = InPrefetch;
+	NextPrefetchIndex = 0;
+	PrefetchBytes = 0;
+}
 
-	Prepass(InPath);
+TSharedRef< FContentPathEnumerator > FContentPathEnumerator::GT_BeginPrepass(
+	TArray< FName > const& InPaths,
+	FContentPrefetchOptions const& InPrefetch
+)
+{
+	TSharedRef< FContentPathEnumerator > Enumerator = MakeShareable(new FContentPathEnumerator(InPrefetch));
+	Enumerator->QueryAssets(InPaths);
+	return Enumerator;
 }
 
-void FContentPathEnumerator::Prepass(FName const& Path)
+bool FContentPathEnumerator::MayHaveDocumentableActions(FAssetData const& AssetData)
 {
+	// Data only blueprints have no functions or macros of their own.
+	// Checking the tag means we don't have to load the blueprint to find that out.
+	bool bIsDataOnly = false;
+	if(AssetData.GetTagValue(TEXT("IsDataOnly"), bIsDataOnly) && bIsDataOnly)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+void FContentPathEnumerator::QueryAssets(TArray< FName > const& Paths)
+{
+	NumPaths = Paths.Num();
+	if(Paths.Num() == 0)
+	{
+		return;
+	}
+
 	auto& AssetRegistryModule = FModuleManager::GetModuleChecked< FAssetRegistryModule >("AssetRegistry");
 	auto& AssetRegistry = AssetRegistryModule.Get();
 
+	// All paths in one query, so overlapping paths don't give duplicates
 	FARFilter Filter;
+	Filter.PackagePaths = Paths;
+	Filter.bRecursivePaths = true;
 	Filter.bRecursiveClasses = true;
 	Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
 	
 	// @TODO: Not sure about this, but for some reason was generating docs for 'AnimInstance' itself.
 	Filter.RecursiveClassesExclusionSet.Add(UAnimBlueprint::StaticClass()->GetFName());
 
-	AssetRegistry.GetAssetsByPath(Path, AssetList, true);
-	AssetRegistry.RunAssetsThroughFilter(AssetList, Filter);
+	AssetRegistry.GetAssets(Filter, AssetList);
+
+	// Package sizes on disk, for budgeting prefetches. Memory use once loaded will be higher, but roughly proportional.
+	// Looked up for every candidate, since the registry can't be used from the thread that finishes the prepass.
+	AssetSizes.Reserve(AssetList.Num());
+	for(auto const& AssetData : AssetList)
+	{
+		auto PackageData = AssetRegistry.GetAssetPackageData(AssetData.PackageName);
+		AssetSizes.Add(PackageData && PackageData->DiskSize > 0 ? PackageData->DiskSize : 0);
+	}
+}
+
+void FContentPathEnumerator::FinishPrepass(FDocGenExclusionFilter const& Exclusions)
+{
+	check(AssetSizes.Num() == AssetList.Num());
+
+	int32 const NumCandidates = AssetList.Num();
+
+	TArray< int32 > Kept;
+	Kept.Reserve(NumCandidates);
+	for(int32 Idx = 0; Idx < NumCandidates; ++Idx)
+	{
+		auto const& AssetData = AssetList[Idx];
+		if(!Exclusions.IsEmpty())
+		{
+			// Content root (eg. 'Game' or a plugin name) stands in for the module
+			FString const PackageName = AssetData.PackageName.ToString();
+			FString ContentRoot;
+			PackageName.RightChop(1).Split(TEXT("/"), &ContentRoot, nullptr);
+
+			if(Exclusions.IsExcluded(AssetData.AssetName.ToString(), ContentRoot, PackageName))
+			{
+				UE_LOG(LogKantanDocGen, Log, TEXT("Excluding blueprint '%s'"), *PackageName);
+				++NumExcluded;
+				continue;
+			}
+		}
+
+		if(MayHaveDocumentableActions(AssetData))
+		{
+			Kept.Add(Idx);
+		}
+		else
+		{
+			++NumSkipped;
+		}
+	}
+
+	// Registry order is arbitrary, keep runs consistent
+	Kept.Sort([this](int32 A, int32 B)
+	{
+		return AssetList[A].ObjectPath.LexicalLess(AssetList[B].ObjectPath);
+	});
+
+	TArray< FAssetData > Candidates = MoveTemp(AssetList);
+	TArray< int64 > CandidateSizes = MoveTemp(AssetSizes);
+	AssetList.Reset(Kept.Num());
+	AssetSizes.Reset(Kept.Num());
+	for(int32 Idx : Kept)
+	{
+		AssetList.Add(MoveTemp(Candidates[Idx]));
+		AssetSizes.Add(CandidateSizes[Idx]);
+	}
+
+	UE_LOG(LogKantanDocGen, Log, TEXT("Found %i blueprints under %i content paths, excluded %i, skipped %i with nothing to document."), NumCandidates, NumPaths, NumExcluded, NumSkipped);
+}
+
+void FContentPathEnumerator::UpdatePrefetch()
+{
+	NextPrefetchIndex = FMath::Max(NextPrefetchIndex, CurIndex);
+
+	while(NextPrefetchIndex < AssetList.Num() && PrefetchRequests.Num() < Prefetch.MaxAssets)
+	{
+		auto const& AssetData = AssetList[NextPrefetchIndex];
+		int64 const Size = AssetSizes[NextPrefetchIndex];
+
+		// Always allow one in flight, however big
+		if(PrefetchRequests.Num() > 0 && PrefetchBytes + Size > Prefetch.MaxBytes)
+		{
+			break;
+		}
+
+		if(!AssetData.IsAssetLoaded())
+		{
+			int32 const RequestId = LoadPackageAsync(AssetData.PackageName.ToString());
+			if(RequestId != INDEX_NONE)
+			{
+				PrefetchRequests.Add(FPrefetchRequest{ NextPrefetchIndex, RequestId });
+				PrefetchBytes += Size;
+			}
+		}
+
+		++NextPrefetchIndex;
+	}
+
+	SET_DWORD_STAT(STAT_KantanDocGen_AssetsPrefetching, PrefetchRequests.Num());
+	TRACE_COUNTER_SET(KantanDocGen_AssetsPrefetching, PrefetchRequests.Num());
+}
+
+UObject* FContentPathEnumerator::WaitForPrefetch(int32 AssetIndex)
+{
+	KANTANDOCGEN_TRACE_SCOPE("AssetLoad");
+
+	if(PrefetchRequests.Num() > 0 && PrefetchRequests[0].AssetIndex == AssetIndex)
+	{
+		// Only blocks if the load hasn't finished in the background yet
+		double const WaitStartTime = FPlatformTime::Seconds();
+		FlushAsyncLoading(PrefetchRequests[0].RequestId);
+		INC_FLOAT_STAT_BY(STAT_KantanDocGen_AssetLoadWait, (FPlatformTime::Seconds() - WaitStartTime) * 1000.0);
+
+		PrefetchBytes -= AssetSizes[AssetIndex];
+		PrefetchRequests.RemoveAt(0, 1, false);
+	}
+
+	// If it wasn't prefetched, or was garbage collected since, this will load it synchronously
+	return AssetList[AssetIndex].GetAsset();
 }
 
 UObject* FContentPathEnumerator::GetNext()
@@ -43,10 +206,16 @@ UObject* FContentPathEnumerator::GetNext()
 
 	while(CurIndex < AssetList.Num())
 	{
-		auto const& AssetData = AssetList[CurIndex];
+		int32 const AssetIndex = CurIndex;
+		auto const& AssetData = AssetList[AssetIndex];
 		++CurIndex;
 
-		if(auto Blueprint = Cast< UBlueprint >(AssetData.GetAsset()))
+		UObject* Asset = WaitForPrefetch(AssetIndex);
+
+		// Start on the following assets, so they load while this one is being documented
+		UpdatePrefetch();
+
+		if(auto Blueprint = Cast< UBlueprint >(Asset))
 		{
 			UE_LOG(LogKantanDocGen, Log, TEXT("Enumerating object '%s' at '%s'"), *Blueprint->GetName(), *AssetData.ObjectPath.ToString());
 
@@ -60,7 +229,7 @@ UObject* FContentPathEnumerator::GetNext()
 
 float FContentPathEnumerator::EstimateProgress() const
 {
-	return (float)CurIndex / (AssetList.Num() - 1);
+	return AssetList.Num() > 0 ? (float)CurIndex / AssetList.Num() : 1.0f;
 }
 
 int32 FContentPathEnumerator::EstimatedSize() const
@@ -8,26 +8,72 @@
 
 #include "ISourceObjectEnumerator.h"
 #include "AssetData.h"
+#include "DocGenExclusionFilter.h"
+
+
+struct FContentPrefetchOptions
+{
+	/** Maximum number of assets being loaded ahead of the one being enumerated. */
+	int32 MaxAssets = 0;
+	/** Maximum total package size on disk of the assets being loaded ahead. */
+	int64 MaxBytes = 0;
+};
 
 
 class FContentPathEnumerator: public ISourceObjectEnumerator
 {
 public:
 	FContentPathEnumerator(
-		FName const& InPath
+		TArray< FName > const& InPaths,
+		FDocGenExclusionFilter const& InExclusions = FDocGenExclusionFilter(),
+		FContentPrefetchOptions const& InPrefetch = FContentPrefetchOptions()
+	);
+
+	/** Queries the asset registry, leaving exclusions, filtering and sorting of the results to FinishPrepass */
+	static TSharedRef< FContentPathEnumerator > GT_BeginPrepass(
+		TArray< FName > const& InPaths,
+		FContentPrefetchOptions const& InPrefetch = FContentPrefetchOptions()
 	);
 
 public:
 	virtual UObject* GetNext() override;
 	virtual float EstimateProgress() const override;
 	virtual int32 EstimatedSize() const override;
+	virtual bool LoadsObjects() const override { return true; }
+	virtual void FinishPrepass(FDocGenExclusionFilter const& Exclusions) override;
+
+	/** Number of blueprints under the paths which were skipped without loading, as they can't have anything to document. */
+	virtual int32 GetNumSkipped() const override { return NumSkipped; }
+	/** Number of blueprints under the paths which matched an exclusion. */
+	virtual int32 GetNumExcluded() const override { return NumExcluded; }
 
 protected:
-	void Prepass(FName const& Path);
+	FContentPathEnumerator(FContentPrefetchOptions const& InPrefetch);
+
+	void QueryAssets(TArray< FName > const& Paths);
+	static bool MayHaveDocumentableActions(FAssetData const& AssetData);
+	void UpdatePrefetch();
+	UObject* WaitForPrefetch(int32 AssetIndex);
 
 protected:
+	struct FPrefetchRequest
+	{
+		int32 AssetIndex;
+		int32 RequestId;
+	};
+
+	// Until the prepass is finished, these are all the blueprints found under the paths
 	TArray< FAssetData > AssetList;
+	TArray< int64 > AssetSizes;
+	int32 NumPaths;
 	int32 CurIndex;
+	int32 NumSkipped;
+	int32 NumExcluded;
+
+	FContentPrefetchOptions Prefetch;
+	TArray< FPrefetchRequest > PrefetchRequests;
+	int32 NextPrefetchIndex;
+	int64 PrefetchBytes;
 };
 
 
@@ -0,0 +1,78 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenExclusionFilter.h"
+
+
+FDocGenExclusionFilter::FDocGenExclusionFilter(TArray< FString > const& Patterns)
+{
+	static const FString RegexPrefix = TEXT("regex:");
+
+	for(auto const& Str : Patterns)
+	{
+		FString Pattern = Str.TrimStartAndEnd();
+		if(Pattern.IsEmpty())
+		{
+			continue;
+		}
+
+		FPattern Entry;
+		if(Pattern.StartsWith(RegexPrefix))
+		{
+			Entry.Pattern = Pattern.RightChop(RegexPrefix.Len());
+			Entry.Regex.Emplace(Entry.Pattern);
+		}
+		else
+		{
+			Entry.Pattern = MoveTemp(Pattern);
+		}
+
+		int32 SlashIdx = INDEX_NONE;
+		(Entry.Pattern.FindChar(TEXT('/'), SlashIdx) ? PathPatterns : NamePatterns).Add(MoveTemp(Entry));
+	}
+}
+
+bool FDocGenExclusionFilter::FPattern::Matches(FString const& Str) const
+{
+	if(Regex.IsSet())
+	{
+		FRegexMatcher Matcher(Regex.GetValue(), Str);
+		return Matcher.FindNext();
+	}
+
+	// Exact names are just wildcard patterns without any wildcards
+	return Str.MatchesWildcard(Pattern);
+}
+
+bool FDocGenExclusionFilter::MatchesAny(TArray< FPattern > const& Patterns, FString const& Str)
+{
+	if(Str.IsEmpty())
+	{
+		return false;
+	}
+
+	for(auto const& Pattern : Patterns)
+	{
+		if(Pattern.Matches(Str))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FDocGenExclusionFilter::IsModuleExcluded(FString const& ModuleName, FString const& PackagePath) const
+{
+	return MatchesAny(NamePatterns, ModuleName) || MatchesAny(PathPatterns, PackagePath);
+}
+
+bool FDocGenExclusionFilter::IsExcluded(FString const& Name, FString const& ModuleName, FString const& PackagePath) const
+{
+	return MatchesAny(NamePatterns, Name) || IsModuleExcluded(ModuleName, PackagePath);
+}
+
+
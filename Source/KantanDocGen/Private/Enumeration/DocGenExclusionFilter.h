@@ -0,0 +1,51 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Internationalization/Regex.h"
+
+
+/*
+Decides which classes and blueprints are left out of the docs, before anything is loaded.
+
+Each pattern is either an exact name, a wildcard pattern ('*' and '?'), or a regular expression prefixed with 'regex:'.
+Matching is case insensitive, except for regular expressions.
+Patterns containing a '/' are matched against package paths (eg. '/Game/Tests/*' or '/Script/MyModule'), any others
+against class or blueprint names and module names.
+*/
+class FDocGenExclusionFilter
+{
+public:
+	FDocGenExclusionFilter() = default;
+	FDocGenExclusionFilter(TArray< FString > const& Patterns);
+
+public:
+	bool IsEmpty() const { return NamePatterns.Num() == 0 && PathPatterns.Num() == 0; }
+
+	/** True if everything in the given module should be excluded */
+	bool IsModuleExcluded(FString const& ModuleName, FString const& PackagePath) const;
+	/** True if the given class or blueprint, with its module (or content root) and package path, should be excluded */
+	bool IsExcluded(FString const& Name, FString const& ModuleName, FString const& PackagePath) const;
+
+protected:
+	struct FPattern
+	{
+		FString Pattern;
+		TOptional< FRegexPattern > Regex;
+
+		bool Matches(FString const& Str) const;
+	};
+
+	static bool MatchesAny(TArray< FPattern > const& Patterns, FString const& Str);
+
+protected:
+	TArray< FPattern > NamePatterns;
+	TArray< FPattern > PathPatterns;
+};
+
+
@@ -10,6 +10,7 @@
 
 
 class UObject;
+class FDocGenExclusionFilter;
 
 class ISourceObjectEnumerator
 {
@@ -17,6 +18,19 @@ public:
 	virtual UObject* GetNext() = 0;
 	virtual float EstimateProgress() const = 0;
 	virtual int32 EstimatedSize() const = 0;
+	/** Whether GetNext may have to load objects. Those that don't can be enumerated far ahead of use. */
+	virtual bool LoadsObjects() const { return false; }
+
+	/**
+	Completes a prepass begun on the game thread, for enumerators created that way (see GT_BeginPrepass of each).
+	Doesn't touch UObjects, so can run on any thread.
+	*/
+	virtual void FinishPrepass(FDocGenExclusionFilter const& Exclusions) {}
+
+	/** Number of objects matching an exclusion */
+	virtual int32 GetNumExcluded() const { return 0; }
+	/** Number of objects skipped without loading, as they can't have anything to document */
+	virtual int32 GetNumSkipped() const { return 0; }
 
 	virtual ~ISourceObjectEnumerator() {}
 };
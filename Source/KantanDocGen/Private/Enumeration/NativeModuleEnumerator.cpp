@@ -12,31 +12,55 @@
 
 
 FNativeModuleEnumerator::FNativeModuleEnumerator(
-	FName const& InModuleName
-)
+	FName const& InModuleName,
+	FDocGenExclusionFilter const& InExclusions
+):
+	FNativeModuleEnumerator()
+{
+	CollectClasses(InModuleName, InExclusions);
+	FinishPrepass(InExclusions);
+}
+
+FNativeModuleEnumerator::FNativeModuleEnumerator()
 {
 	CurIndex = 0;
+	NumExcluded = 0;
+}
 
-	Prepass(InModuleName);
+TSharedRef< FNativeModuleEnumerator > FNativeModuleEnumerator::GT_BeginPrepass(
+	FName const& InModuleName,
+	FDocGenExclusionFilter const& InExclusions
+)
+{
+	TSharedRef< FNativeModuleEnumerator > Enumerator = MakeShareable(new FNativeModuleEnumerator());
+	Enumerator->CollectClasses(InModuleName, InExclusions);
+	return Enumerator;
 }
 
-void FNativeModuleEnumerator::Prepass(FName const& ModuleName)
+void FNativeModuleEnumerator::CollectClasses(FName const& InModuleName, FDocGenExclusionFilter const& Exclusions)
 {
 	// For native package, all classes are already loaded so it's no problem to fully enumerate during prepass.
 	// That way we have more info for progress estimation.
 
-	// Attempt to find the package
-	auto PkgName = TEXT("/Script/") + ModuleName.ToString();
+	ModuleName = InModuleName;
+	PackageName = TEXT("/Script/") + ModuleName.ToString();
+
+	if(Exclusions.IsModuleExcluded(ModuleName.ToString(), PackageName))
+	{
+		UE_LOG(LogKantanDocGen, Log, TEXT("Module '%s' is excluded, skipping."), *ModuleName.ToString());
+		return;
+	}
 
-	auto Package = FindPackage(nullptr, *PkgName);
+	// Attempt to find the package
+	auto Package = FindPackage(nullptr, *PackageName);
 	if(Package == nullptr)
 	{
 		// If it is not in memory, try to load it.
-		Package = LoadPackage(nullptr, *PkgName, LOAD_None);
+		Package = LoadPackage(nullptr, *PackageName, LOAD_None);
 	}
 	if(Package == nullptr)
 	{
-		UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to find specified package '%s', skipping."), *PkgName);
+		UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to find specified package '%s', skipping."), *PackageName);
 		return;
 	}
 
@@ -65,12 +89,11 @@ void FNativeModuleEnumerator::Prepass(FName const& ModuleName)
 
 		if(ObjectToProcess && !Processed.Contains(ObjectToProcess))
 		{
-			UE_LOG(LogKantanDocGen, Log, TEXT("Enumerating object '%s' in package '%s'"), *ObjectToProcess->GetName(), *PkgName);
+			Processed.Add(ObjectToProcess);
 
-			// Store this class
+			// Store this class, exclusions are applied by FinishPrepass
 			ObjectList.Add(ObjectToProcess);
-
-			Processed.Add(ObjectToProcess);
+			ObjectNames.Add(ObjectToProcess->GetName());
 		}
 	};
 
@@ -78,6 +101,29 @@ void FNativeModuleEnumerator::Prepass(FName const& ModuleName)
 	ForEachObjectWithOuter(Package, ObjectEnumFtr, true /* Include nested */);
 }
 
+void FNativeModuleEnumerator::FinishPrepass(FDocGenExclusionFilter const& Exclusions)
+{
+	check(ObjectNames.Num() == ObjectList.Num());
+
+	FString const ModuleNameStr = ModuleName.ToString();
+	int32 NumKept = 0;
+	for(int32 Idx = 0; Idx < ObjectList.Num(); ++Idx)
+	{
+		if(Exclusions.IsExcluded(ObjectNames[Idx], ModuleNameStr, PackageName))
+		{
+			UE_LOG(LogKantanDocGen, Log, TEXT("Excluding object '%s' in package '%s'"), *ObjectNames[Idx], *PackageName);
+			++NumExcluded;
+			continue;
+		}
+
+		UE_LOG(LogKantanDocGen, Log, TEXT("Enumerating object '%s' in package '%s'"), *ObjectNames[Idx], *PackageName);
+		ObjectList[NumKept++] = ObjectList[Idx];
+	}
+
+	ObjectList.SetNum(NumKept);
+	ObjectNames.Empty();
+}
+
 UObject* FNativeModuleEnumerator::GetNext()
 {
 	return CurIndex < ObjectList.Num() ? ObjectList[CurIndex++].Get() : nullptr;
@@ -85,7 +131,7 @@ UObject* FNativeModuleEnumerator::GetNext()
 
 float FNativeModuleEnumerator::EstimateProgress() const
 {
-	return (float)CurIndex / (ObjectList.Num() - 1);
+	return ObjectList.Num() > 0 ? (float)CurIndex / ObjectList.Num() : 1.0f;
 }
 
 int32 FNativeModuleEnumerator::EstimatedSize() const
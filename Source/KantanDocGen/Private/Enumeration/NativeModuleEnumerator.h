@@ -7,26 +7,44 @@
 #pragma once
 
 #include "ISourceObjectEnumerator.h"
+#include "DocGenExclusionFilter.h"
 
 
 class FNativeModuleEnumerator: public ISourceObjectEnumerator
 {
 public:
 	FNativeModuleEnumerator(
-		FName const& InModuleName
+		FName const& InModuleName,
+		FDocGenExclusionFilter const& InExclusions = FDocGenExclusionFilter()
+	);
+
+	/** Finds the module's classes, leaving exclusion of individual classes to FinishPrepass */
+	static TSharedRef< FNativeModuleEnumerator > GT_BeginPrepass(
+		FName const& InModuleName,
+		FDocGenExclusionFilter const& InExclusions
 	);
 
 public:
 	virtual UObject* GetNext() override;
 	virtual float EstimateProgress() const override;
 	virtual int32 EstimatedSize() const override;
+	virtual void FinishPrepass(FDocGenExclusionFilter const& Exclusions) override;
+
+	virtual int32 GetNumExcluded() const override { return NumExcluded; }
 
 protected:
-	void Prepass(FName const& ModuleName);
+	FNativeModuleEnumerator();
+
+	void CollectClasses(FName const& InModuleName, FDocGenExclusionFilter const& Exclusions);
 
 protected:
+	FName ModuleName;
+	FString PackageName;
 	TArray< TWeakObjectPtr< UObject > > ObjectList;
+	// Names of the classes in ObjectList, gathered so that exclusions can be applied off the game thread. Only until the prepass is finished.
+	TArray< FString > ObjectNames;
 	int32 CurIndex;
+	int32 NumExcluded;
 };
 
 
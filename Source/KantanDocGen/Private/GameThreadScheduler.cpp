@@ -0,0 +1,141 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "GameThreadScheduler.h"
+#include "KantanDocGenLog.h"
+#include "KantanDocGenStats.h"
+#include "KantanDocGenTrace.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+
+FDocGenGameThreadScheduler* FDocGenGameThreadScheduler::Instance = nullptr;
+
+
+void FDocGenGameThreadScheduler::Startup()
+{
+	check(IsInGameThread());
+	check(Instance == nullptr);
+
+	Instance = new FDocGenGameThreadScheduler();
+}
+
+void FDocGenGameThreadScheduler::Shutdown()
+{
+	check(IsInGameThread());
+
+	delete Instance;
+	Instance = nullptr;
+}
+
+FDocGenGameThreadScheduler& FDocGenGameThreadScheduler::Get()
+{
+	check(Instance);
+	return *Instance;
+}
+
+FDocGenGameThreadScheduler::FDocGenGameThreadScheduler():
+	BudgetMicroseconds(5000)
+{
+	TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FDocGenGameThreadScheduler::Tick), 0.0f);
+}
+
+FDocGenGameThreadScheduler::~FDocGenGameThreadScheduler()
+{
+	FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	// Anything still queued may have a worker waiting on its result, so run it all before going away.
+	Drain(TNumericLimits< double >::Max());
+}
+
+void FDocGenGameThreadScheduler::Enqueue(TUniqueFunction< void() > Work)
+{
+	Pending.Enqueue(MoveTemp(Work));
+	// Not inside the trace macro, which compiles away along with its arguments
+	int32 const NumQueued = NumPending.Increment();
+	TRACE_COUNTER_SET(KantanDocGen_GameThreadQueue, NumQueued);
+}
+
+void FDocGenGameThreadScheduler::SetFrameBudget(float InBudgetMs)
+{
+	BudgetMicroseconds = FMath::Max(FMath::RoundToInt(InBudgetMs * 1000.0f), 0);
+}
+
+float FDocGenGameThreadScheduler::GetFrameBudget() const
+{
+	return BudgetMicroseconds.Load() / 1000.0f;
+}
+
+FDocGenGameThreadScheduler::FFrameStats FDocGenGameThreadScheduler::ConsumeStats()
+{
+	FScopeLock Lock(&StatsCS);
+
+	FFrameStats Result = Stats;
+	Stats = FFrameStats();
+	return Result;
+}
+
+bool FDocGenGameThreadScheduler::Tick(float DeltaTime)
+{
+	double const BudgetSeconds = BudgetMicroseconds.Load() / 1000000.0;
+	double const StartTime = FPlatformTime::Seconds();
+
+	int32 const NumItems = Drain(BudgetSeconds);
+	if(NumItems > 0)
+	{
+		double const WorkTime = FPlatformTime::Seconds() - StartTime;
+
+		SET_FLOAT_STAT(STAT_KantanDocGen_GameThreadFrameWork, WorkTime * 1000.0);
+
+		FScopeLock Lock(&StatsCS);
+		++Stats.NumFrames;
+		Stats.NumItems += NumItems;
+		Stats.TotalWorkTime += WorkTime;
+		Stats.TotalFrameTime += DeltaTime;
+		Stats.MaxFrameWorkTime = FMath::Max(Stats.MaxFrameWorkTime, WorkTime);
+		if(WorkTime > BudgetSeconds)
+		{
+			++Stats.NumOverBudgetFrames;
+		}
+	}
+
+	// Keep ticking
+	return true;
+}
+
+void FDocGenGameThreadScheduler::Flush()
+{
+	check(IsInGameThread());
+
+	Drain(TNumericLimits< double >::Max());
+}
+
+int32 FDocGenGameThreadScheduler::Drain(double BudgetSeconds)
+{
+	KANTANDOCGEN_TRACE_SCOPE("GameThreadWork");
+
+	double const StartTime = FPlatformTime::Seconds();
+
+	// Always run at least one item per frame, so that progress is guaranteed even with a zero budget.
+	int32 NumItems = 0;
+	TUniqueFunction< void() > Work;
+	while(Pending.Dequeue(Work))
+	{
+		int32 const NumQueued = NumPending.Decrement();
+		TRACE_COUNTER_SET(KantanDocGen_GameThreadQueue, NumQueued);
+		Work();
+		++NumItems;
+
+		if(FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	return NumItems;
+}
+
+
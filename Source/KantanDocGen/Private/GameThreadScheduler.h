@@ -0,0 +1,74 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Templates/Function.h"
+
+
+/*
+Drains doc gen work queued for the game thread from a core ticker, doing no more than a fixed time budget's
+worth of work in any single frame. Work can be queued from any thread.
+*/
+class FDocGenGameThreadScheduler
+{
+public:
+	struct FFrameStats
+	{
+		int32 NumFrames = 0;			// Frames in which any doc gen work was done
+		int32 NumOverBudgetFrames = 0;
+		int32 NumItems = 0;
+		double TotalWorkTime = 0.0;
+		double MaxFrameWorkTime = 0.0;
+		double TotalFrameTime = 0.0;	// Sum of frame deltas for the frames counted in NumFrames
+	};
+
+public:
+	/** Game thread only */
+	static void Startup();
+	static void Shutdown();
+	/**/
+
+	static FDocGenGameThreadScheduler& Get();
+
+public:
+	void Enqueue(TUniqueFunction< void() > Work);
+
+	void SetFrameBudget(float InBudgetMs);
+	float GetFrameBudget() const;
+
+	/** Runs everything queued regardless of the budget, for when the core ticker isn't being ticked. Game thread only. */
+	void Flush();
+
+	/** Returns frame stats accumulated since the last call, and resets them. */
+	FFrameStats ConsumeStats();
+
+protected:
+	FDocGenGameThreadScheduler();
+	~FDocGenGameThreadScheduler();
+
+	bool Tick(float DeltaTime);
+	int32 Drain(double BudgetSeconds);
+
+protected:
+	TQueue< TUniqueFunction< void() >, EQueueMode::Mpsc > Pending;
+	FThreadSafeCounter NumPending;	// Only for tracing
+	FDelegateHandle TickerHandle;
+
+	TAtomic< int32 > BudgetMicroseconds;
+
+	mutable FCriticalSection StatsCS;
+	FFrameStats Stats;
+
+	static FDocGenGameThreadScheduler* Instance;
+};
+
+
@@ -6,17 +6,20 @@
 
 #include "KantanDocGenModule.h"
 #include "KantanDocGenLog.h"
+#include "KantanDocGenStats.h"
+#include "KantanDocGenTrace.h"
 #include "KantanDocGenCommands.h"
 #include "DocGenSettings.h"
 #include "DocGenTaskProcessor.h"
+#include "GameThreadScheduler.h"
 #include "UI/SKantanDocGenWidget.h"
+#include "Benchmark/DocGenBenchmark.h"
 
 #include "HAL/IConsoleManager.h"
 #include "Interfaces/IMainFrameModule.h"
 #include "LevelEditor.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
 #include "Framework/Application/SlateApplication.h"
-#include "HAL/RunnableThread.h"
 
 #define LOCTEXT_NAMESPACE "KantanDocGen"
 
@@ -25,9 +28,48 @@ IMPLEMENT_MODULE(FKantanDocGenModule, KantanDocGen)
 
 DEFINE_LOG_CATEGORY(LogKantanDocGen);
 
+DEFINE_STAT(STAT_KantanDocGen_SpawnHopLatency);
+DEFINE_STAT(STAT_KantanDocGen_NodesPerSpawnHop);
+DEFINE_STAT(STAT_KantanDocGen_GameThreadFrameWork);
+DEFINE_STAT(STAT_KantanDocGen_AssetsPrefetching);
+DEFINE_STAT(STAT_KantanDocGen_AssetLoadWait);
+
+UE_TRACE_CHANNEL_DEFINE(KantanDocGenChannel);
+
+TRACE_DECLARE_INT_COUNTER(KantanDocGen_GameThreadQueue, TEXT("KantanDocGen/Game Thread Queue"));
+TRACE_DECLARE_INT_COUNTER(KantanDocGen_NodesInFlight, TEXT("KantanDocGen/Nodes In Flight"));
+TRACE_DECLARE_INT_COUNTER(KantanDocGen_ImageWritesInFlight, TEXT("KantanDocGen/Image Writes In Flight"));
+TRACE_DECLARE_INT_COUNTER(KantanDocGen_PendingHtmlRenders, TEXT("KantanDocGen/Pending Html Renders"));
+TRACE_DECLARE_INT_COUNTER(KantanDocGen_AssetsPrefetching, TEXT("KantanDocGen/Assets Prefetching"));
+
 
 void FKantanDocGenModule::StartupModule()
 {
+	FDocGenGameThreadScheduler::Startup();
+
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("KantanDocGen.Benchmark.Xml"),
+		TEXT("Runs the automation tests comparing DOM and streamed construction of node xml documents. Args: [NumDocs]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&DocGenBenchmark::ExecXmlBenchmarks),
+		ECVF_Default
+	));
+
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("KantanDocGen.Benchmark.Pipeline"),
+		TEXT("Runs the automation tests benchmarking enumeration prepasses, spawner filtering, pin parsing and node doc generation against engine modules. Args: [NumIterations]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&DocGenBenchmark::ExecPipelineBenchmarks),
+		ECVF_Default
+	));
+
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("KantanDocGen.Status"),
+		TEXT("Logs the state of the doc gen worker and its queue."),
+		FConsoleCommandDelegate::CreateRaw(this, &FKantanDocGenModule::LogQueueStatus),
+		ECVF_Default
+	));
+
+	// No editor UI to extend when running as a commandlet
+	if(!IsRunningCommandlet())
 	{
 		// Create command list
 		UICommands = MakeShared< FUICommandList >();
@@ -63,7 +105,22 @@ void FKantanDocGenModule::StartupModule()
 
 void FKantanDocGenModule::ShutdownModule()
 {
-	FKantanDocGenCommands::Unregister();
+	for(auto Cmd : ConsoleCommands)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(Cmd);
+	}
+	ConsoleCommands.Empty();
+
+	if(UICommands.IsValid())
+	{
+		FKantanDocGenCommands::Unregister();
+		UICommands.Reset();
+	}
+
+	// Needs the scheduler to wind up any running task
+	Processor.Reset();
+
+	FDocGenGameThreadScheduler::Shutdown();
 }
 
 // @TODO: Idea was to allow quoted values containing spaces, but this isn't possible since the initial console string has
@@ -88,14 +145,30 @@ void FKantanDocGenModule::GenerateDocs(FKantanDocGenSettings const& Settings)
 	if(!Processor.IsValid())
 	{
 		Processor = MakeUnique< FDocGenTaskProcessor >();
+		Processor->StartWorker(TPri_BelowNormal);
 	}
 	
 	Processor->QueueTask(Settings);
+}
 
-	if(!Processor->IsRunning())
+void FKantanDocGenModule::LogQueueStatus()
+{
+	if(!Processor.IsValid())
 	{
-		FRunnableThread::Create(Processor.Get(), TEXT("KantanDocGenProcessorThread"), 0, TPri_BelowNormal);
+		UE_LOG(LogKantanDocGen, Display, TEXT("Doc gen worker not started, nothing has been queued."));
+		return;
 	}
+
+	auto const Status = Processor->GetQueueStatus();
+	UE_LOG(LogKantanDocGen, Display, TEXT("Doc gen worker %s. %s. %i waiting%s%s. %i completed, %i requests coalesced."),
+		Status.bWorkerRunning ? TEXT("running") : TEXT("stopped"),
+		Status.ActiveTitle.IsEmpty() ? TEXT("Idle") : *FString::Printf(TEXT("Generating '%s' (%.1f%%)"), *Status.ActiveTitle, Status.ActiveProgressPermille / 10.0f),
+		Status.WaitingTitles.Num(),
+		Status.WaitingTitles.Num() > 0 ? TEXT(": ") : TEXT(""),
+		*FString::Join(Status.WaitingTitles, TEXT(", ")),
+		Status.NumCompleted,
+		Status.NumCoalesced
+	);
 }
 
 void FKantanDocGenModule::ShowDocGenUI()
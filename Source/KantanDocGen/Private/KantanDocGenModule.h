@@ -11,6 +11,7 @@
 
 
 class FUICommandList;
+struct IConsoleObject;
 
 /*
 Module implementation
@@ -32,11 +33,13 @@ public:
 protected:
 	void ProcessIntermediateDocs(FString const& IntermediateDir, FString const& OutputDir, FString const& DocTitle, bool bCleanOutput);
 	void ShowDocGenUI();
+	void LogQueueStatus();
 
 protected:
 	TUniquePtr< FDocGenTaskProcessor > Processor;
 
 	TSharedPtr< FUICommandList > UICommands;
+	TArray< IConsoleObject* > ConsoleCommands;
 };
 
 
@@ -0,0 +1,18 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+
+DECLARE_STATS_GROUP(TEXT("KantanDocGen"), STATGROUP_KantanDocGen, STATCAT_Advanced);
+
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Spawn Hop Latency (ms)"), STAT_KantanDocGen_SpawnHopLatency, STATGROUP_KantanDocGen, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nodes Per Spawn Hop"), STAT_KantanDocGen_NodesPerSpawnHop, STATGROUP_KantanDocGen, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Game Thread Work Per Frame (ms)"), STAT_KantanDocGen_GameThreadFrameWork, STATGROUP_KantanDocGen, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Assets Prefetching"), STAT_KantanDocGen_AssetsPrefetching, STATGROUP_KantanDocGen, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Asset Load Wait (ms)"), STAT_KantanDocGen_AssetLoadWait, STATGROUP_KantanDocGen, );
@@ -0,0 +1,23 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+
+// Run with -trace=cpu,counters,KantanDocGen to see doc gen scopes and counters in Unreal Insights.
+UE_TRACE_CHANNEL_EXTERN(KantanDocGenChannel);
+
+#define KANTANDOCGEN_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(TEXT("KantanDocGen::") TEXT(Name), KantanDocGenChannel)
+
+TRACE_DECLARE_INT_COUNTER_EXTERN(KantanDocGen_GameThreadQueue);
+TRACE_DECLARE_INT_COUNTER_EXTERN(KantanDocGen_NodesInFlight);
+TRACE_DECLARE_INT_COUNTER_EXTERN(KantanDocGen_ImageWritesInFlight);
+TRACE_DECLARE_INT_COUNTER_EXTERN(KantanDocGen_PendingHtmlRenders);
+TRACE_DECLARE_INT_COUNTER_EXTERN(KantanDocGen_AssetsPrefetching);
@@ -8,35 +8,79 @@
 
 #include "NodeDocsGenerator.h"
 #include "KantanDocGenLog.h"
-#include "SGraphNode.h"
-#include "SGraphPanel.h"
-#include "NodeFactory.h"
+#include "KantanDocGenTrace.h"
 #include "EdGraphSchema_K2.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "BlueprintActionDatabase.h"
 #include "BlueprintNodeSpawner.h"
 #include "BlueprintFunctionNodeSpawner.h"
-#include "BlueprintBoundNodeSpawner.h"
-#include "BlueprintComponentNodeSpawner.h"
-#include "BlueprintEventNodeSpawner.h"
-#include "K2Node_DynamicCast.h"
-#include "K2Node_Message.h"
-#include "HighResScreenshot.h"
-#include "XmlFile.h"
-#include "Slate/WidgetRenderer.h"
-#include "Engine/TextureRenderTarget2D.h"
-#include "TextureResource.h"
+#include "K2Node_CallFunction.h"
 #include "ThreadingHelpers.h"
 #include "Stats/StatsMisc.h"
-#include "Runtime/ImageWriteQueue/Public/ImageWriteTask.h"
+#include "Output/DocGenImageWriter.h"
+#include "Output/DocGenWidgetImageBackend.h"
+#include "Output/DocGenSvgImageBackend.h"
+#include "Output/DocGenXmlWriter.h"
+#include "Output/DocGenIntermediateFormat.h"
+#include "BlueprintNodeSignature.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+
+
+namespace
+{
+	// Bump whenever a change to the generator affects its output, to invalidate docs from previous runs
+	const int32 DocFormatVersion = 3;
+
+	// Description part of a K2 pin's hover text
+	FString GetPinHoverDescription(UEdGraphPin* Pin)
+	{
+		FString Tooltip;
+		Pin->GetOwningNode()->GetPinHoverText(*Pin, Tooltip);
+
+		if(Tooltip.IsEmpty())
+		{
+			return FString();
+		}
+
+		// @NOTE: This is based on the formatting in UEdGraphSchema_K2::ConstructBasicPinTooltip.
+		// If that is changed, this will fail!
+		
+		auto TooltipPtr = *Tooltip;
+
+		// Skip name and type lines
+		FString Buf;
+		FParse::Line(&TooltipPtr, Buf);
+		FParse::Line(&TooltipPtr, Buf);
+
+		// Currently there is an empty line here, but FParse::Line seems to gobble up empty lines as part of the previous call.
+		// Anyway, attempting here to deal with this generically in case that weird behaviour changes.
+		while(*TooltipPtr == TEXT('\n'))
+		{
+			FParse::Line(&TooltipPtr, Buf);
+		}
+
+		// What remains is the description
+		return TooltipPtr;
+	}
+}
+
+FNodeDocsGenerator::FNodeDocsGenerator(int32 MaxPendingImageWrites)
+{
+	ImageWriter = MakeUnique< FDocGenImageWriter >(MaxPendingImageWrites);
+	XmlWriter = MakeUnique< FDocGenXmlWriter >();
+}
 
 FNodeDocsGenerator::~FNodeDocsGenerator()
 {
+	ImageWriter.Reset();
+
 	CleanUp();
 }
 
-bool FNodeDocsGenerator::GT_Init(FString const& InDocsTitle, FString const& InOutputDir, UClass* BlueprintContextClass)
+bool FNodeDocsGenerator::GT_Init(FString const& InDocsTitle, FString const& InOutputDir, UClass* BlueprintContextClass, bool bIncremental, bool bInGenerateImages, EDocGenImageFormat ImageFormat)
 {
 	DummyBP = CastChecked< UBlueprint >(FKismetEditorUtilities::CreateBlueprint(
 		BlueprintContextClass,
@@ -57,28 +101,51 @@ bool FNodeDocsGenerator::GT_Init(FString const& InDocsTitle, FString const& InOu
 	DummyBP->AddToRoot();
 	Graph->AddToRoot();
 
-	GraphPanel = SNew(SGraphPanel)
-		.GraphObj(Graph.Get())
-		;
-	// We want full detail for rendering, passing a super-high zoom value will guarantee the highest LOD.
-	GraphPanel->RestoreViewSettings(FVector2D(0, 0), 10.0f);
+	// Widget rendering may not be possible (eg. running headless), so backends are only created when images are wanted
+	bGenerateImages = bInGenerateImages;
+	if(bGenerateImages)
+	{
+		switch(ImageFormat)
+		{
+		case EDocGenImageFormat::Svg:
+			ImageBackend = MakeUnique< FDocGenSvgImageBackend >();
+			break;
+		default:
+			ImageBackend = MakeUnique< FDocGenWidgetImageBackend >();
+			break;
+		}
+
+		if(!ImageBackend->GT_Init(Graph.Get()))
+		{
+			return false;
+		}
+	}
 
 	DocsTitle = InDocsTitle;
 
-	IndexXml = InitIndexXml(DocsTitle);
 	ClassDocsMap.Empty();
 
 	OutputDir = InOutputDir;
 
+	PrevManifest.Reset();
+	Manifest.Reset();
+	FunctionDocs.Reset();
+	KnownImages.Empty();
+	NumEncodedImages = 0;
+	NumDuplicateImages = 0;
+	PendingImagePaths.Empty();
+	WrittenImageBytes = 0;
+	if(bIncremental)
+	{
+		PrevManifest.Load(GetManifestPath());
+	}
+
 	return true;
 }
 
 UK2Node* FNodeDocsGenerator::GT_InitializeForSpawner(UBlueprintNodeSpawner* Spawner, UObject* SourceObject, FNodeProcessingState& OutState)
 {
-	if(!IsSpawnerDocumentable(Spawner, SourceObject->IsA< UBlueprint >()))
-	{
-		return nullptr;
-	}
+	KANTANDOCGEN_TRACE_SCOPE("Spawn");
 
 	// Spawn an instance into the graph
 	auto NodeInst = Spawner->Invoke(Graph.Get(), IBlueprintNodeBinder::FBindingSet{}, FVector2D(0, 0));
@@ -96,21 +163,58 @@ UK2Node* FNodeDocsGenerator::GT_InitializeForSpawner(UBlueprintNodeSpawner* Spaw
 
 	if(!ClassDocsMap.Contains(AssociatedClass))
 	{
-		// New class xml file needs adding
-		ClassDocsMap.Add(AssociatedClass, InitClassDocXml(AssociatedClass));
-		// Also update the index xml
-		UpdateIndexDocWithClass(IndexXml.Get(), AssociatedClass);
+		// New class doc needs adding
+		FDocGenClassEntryPtr ClassDoc = MakeShared< FDocGenClassEntry, ESPMode::ThreadSafe >();
+		ClassDoc->Id = GetClassDocId(AssociatedClass);
+		ClassDoc->DisplayName = FBlueprintEditorUtils::GetFriendlyClassDisplayName(AssociatedClass).ToString();
+		ClassDocsMap.Add(AssociatedClass, ClassDoc);
 	}
 	
 	OutState = FNodeProcessingState();
-	OutState.ClassDocXml = ClassDocsMap.FindChecked(AssociatedClass);
+	OutState.ClassDoc = ClassDocsMap.FindChecked(AssociatedClass);
 	OutState.ClassDocsPath = OutputDir / GetClassDocId(AssociatedClass);
+	OutState.NodeId = GetNodeDocId(K2NodeInst);
+	OutState.NodeShortTitle = K2NodeInst->GetNodeTitle(ENodeTitleType::ListView).ToString();
+	OutState.NodeHash = ComputeNodeHash(K2NodeInst, Spawner, *OutState.ClassDoc);
+
+	// See if the docs from the last run are still valid
+	if(auto PrevRecord = PrevManifest.Nodes.Find(FDocGenManifest::MakeNodeKey(OutState.ClassDoc->Id, OutState.NodeId)))
+	{
+		// Docs generated without an image (or with another image format) can only be reused when we're still not generating images, and vice versa
+		bool const bImageUpToDate = bGenerateImages ?
+			FPaths::GetExtension(PrevRecord->ImageFilename) == ImageBackend->GetExtension() && FPaths::FileExists(GetImageDir() / PrevRecord->ImageFilename) :
+			PrevRecord->ImageFilename.IsEmpty();
+
+		OutState.bUpToDate = PrevRecord->Hash == OutState.NodeHash
+			&& FPaths::FileExists(DocGenIntermediate::GetNodePath(OutputDir, OutState.ClassDoc->Id, OutState.NodeId))
+			&& bImageUpToDate
+			;
+
+		// Anything being regenerated gets its image (if any) from this run, so must not keep a stale one
+		if(OutState.bUpToDate)
+		{
+			OutState.ImageFilename = PrevRecord->ImageFilename;
+		}
+	}
 
 	return K2NodeInst;
 }
 
+void FNodeDocsGenerator::GT_RemoveNode(UEdGraphNode* Node)
+{
+	// Also breaks any links, so nothing in the graph references the node or its pins
+	if(Graph.IsValid())
+	{
+		Graph->RemoveNode(Node);
+	}
+	Node->MarkPendingKill();
+}
+
 bool FNodeDocsGenerator::GT_Finalize(FString OutputPath)
 {
+	UpdateHashes();
+	RemoveStaleIntermediates(OutputPath);
+
 	if(!SaveClassDocXml(OutputPath))
 	{
 		return false;
@@ -126,10 +230,7 @@ bool FNodeDocsGenerator::GT_Finalize(FString OutputPath)
 
 void FNodeDocsGenerator::CleanUp()
 {
-	if(GraphPanel.IsValid())
-	{
-		GraphPanel.Reset();
-	}
+	ImageBackend.Reset();
 
 	if(DummyBP.IsValid())
 	{
@@ -146,309 +247,414 @@ void FNodeDocsGenerator::CleanUp()
 bool FNodeDocsGenerator::GenerateNodeImage(UEdGraphNode* Node, FNodeProcessingState& State)
 {
 	SCOPE_SECONDS_COUNTER(GenerateNodeImageTime);
-
-	const FVector2D DrawSize(1024.0f, 1024.0f);
-
-	bool bSuccess = false;
+	KANTANDOCGEN_TRACE_SCOPE("NodeImage");
 
 	AdjustNodeForSnapshot(Node);
 
-	FString NodeName = GetNodeDocId(Node);
+	FDocGenNodeImage Image;
+	if(!ImageBackend->RenderNode(Node, Image))
+	{
+		return false;
+	}
 
-	FIntRect Rect;
+	// Images are stored once in a shared directory, named by content, since many nodes render identically.
+	// Relative to the node docs, which are in <class>/nodes.
+	State.RelImageBasePath = TEXT("../../img");
+	State.ImageFilename = FString::Printf(TEXT("%016llx.%s"), Image.ContentHash, ImageBackend->GetExtension());
 
-	TUniquePtr<TImagePixelData<FColor>> PixelData;
+	FString const ImagePath = GetImageDir() / State.ImageFilename;
 
-	bSuccess = DocGenThreads::RunOnGameThreadRetVal([this, Node, DrawSize, &Rect, &PixelData]
+	bool bAlreadyExists = false;
+	KnownImages.Add(State.ImageFilename, &bAlreadyExists);
+	if(bAlreadyExists || FPaths::FileExists(ImagePath))
 	{
-		auto NodeWidget = FNodeFactory::CreateNodeWidget(Node);
-		NodeWidget->SetOwner(GraphPanel.ToSharedRef());
+		++NumDuplicateImages;
+		return true;
+	}
 
-		const bool bUseGammaCorrection = false;
-		FWidgetRenderer Renderer(bUseGammaCorrection);
-		Renderer.SetIsPrepassNeeded(true);
-		auto RenderTarget = Renderer.DrawWidget(NodeWidget.ToSharedRef(), DrawSize);
+	// Encoding happens in the background, failures are reported by FlushImageWrites
+	ImageWriter->Enqueue(ImagePath, MoveTemp(Image.Write));
+	PendingImagePaths.Add(ImagePath);
+	++NumEncodedImages;
 
-		auto Desired = NodeWidget->GetDesiredSize();
-	
-		FTextureRenderTargetResource* RTResource = RenderTarget->GameThread_GetRenderTargetResource();
-		Rect = FIntRect(0, 0, (int32)Desired.X, (int32)Desired.Y);
-		FReadSurfaceDataFlags ReadPixelFlags(RCM_UNorm);
-		ReadPixelFlags.SetLinearToGamma(true); // @TODO: is this gamma correction, or something else?
+	return true;
+}
 
-		PixelData = MakeUnique<TImagePixelData<FColor>>(FIntPoint((int32)Desired.X, (int32)Desired.Y));
-		PixelData->Pixels.SetNumUninitialized(Desired.X * Desired.Y);
+FNodeDocsGenerator::FGenerationStats FNodeDocsGenerator::GetStats() const
+{
+	FGenerationStats Stats;
+	Stats.NodeImageTime = GenerateNodeImageTime;
+	Stats.NodeDocsTime = GenerateNodeDocsTime;
+	Stats.ImageEncodeTime = ImageWriter->GetStats().TotalEncodeTime;
+	Stats.NumImagesEncoded = NumEncodedImages;
+	Stats.NumImagesReused = NumDuplicateImages;
+	Stats.ImageBytes = WrittenImageBytes;
+	Stats.XmlBytes = XmlWriter->GetBytesSaved();
+	return Stats;
+}
 
-		if(RTResource->ReadPixelsPtr(PixelData->Pixels.GetData(), ReadPixelFlags, Rect) == false)
-		{
-			UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to read pixels for node image."));
-			return false;
-		}
+bool FNodeDocsGenerator::FlushImageWrites()
+{
+	int32 const NumFailed = ImageWriter->Flush();
 
-		return true;
-	});
+	for(auto const& Path : PendingImagePaths)
+	{
+		WrittenImageBytes += FMath::Max< int64 >(IFileManager::Get().FileSize(*Path), 0);
+	}
+	PendingImagePaths.Empty();
 
-	if(!bSuccess)
+	UE_LOG(LogKantanDocGen, Log, TEXT("Node images: %i encoded, %i identical to an existing image."), NumEncodedImages, NumDuplicateImages);
+	if(NumFailed > 0)
 	{
+		UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to save %i node images, see above."), NumFailed);
 		return false;
 	}
 
-	State.RelImageBasePath = TEXT("../img");
-	FString ImageBasePath = State.ClassDocsPath / TEXT("img");// State.RelImageBasePath;
-	FString ImgFilename = FString::Printf(TEXT("nd_img_%s.png"), *NodeName);
-	FString ScreenshotSaveName = ImageBasePath / ImgFilename;
+	return true;
+}
 
-	TUniquePtr<FImageWriteTask> ImageTask = MakeUnique<FImageWriteTask>();
-	ImageTask->PixelData = MoveTemp(PixelData);
-	ImageTask->Filename = ScreenshotSaveName;
-	ImageTask->Format = EImageFormat::PNG;
-	ImageTask->CompressionQuality = (int32)EImageCompressionQuality::Default;
-	ImageTask->bOverwriteFile = true;
-	ImageTask->PixelPreProcessors.Add(TAsyncAlphaWrite<FColor>(255));
-	
-	if(ImageTask->RunTask())
-	{
-		// Success!
-		bSuccess = true;
-		State.ImageFilename = ImgFilename;
-	}
-	else
+// For K2 pins only!
+bool FNodeDocsGenerator::ExtractPinInformation(UEdGraphPin* Pin, FDocGenFunctionDoc const* FunctionDoc, FString& OutName, FString& OutType, FString& OutDescription)
+{
+	// Pins without an entry in the function doc (such as the self pin) still get the engine's description
+	auto PinDoc = FunctionDoc ? FunctionDoc->FindPinDoc(Pin->PinName) : nullptr;
+	OutDescription = PinDoc ? *PinDoc : GetPinHoverDescription(Pin);
+
+	// Name and type come straight from the pin, as that is more robust to future engine changes than the tooltip.
+
+	OutName = Pin->GetDisplayName().ToString();
+	if(OutName.IsEmpty() && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
 	{
-		UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to save screenshot image for node: %s"), *NodeName);
+		OutName = Pin->Direction == EEdGraphPinDirection::EGPD_Input ? TEXT("In") : TEXT("Out");
 	}
 
-	return bSuccess;
-}
+	OutType = UEdGraphSchema_K2::TypeToText(Pin->PinType).ToString();
 
-inline FString WrapAsCDATA(FString const& InString)
-{
-	return TEXT("<![CDATA[") + InString + TEXT("]]>");
+	return true;
 }
 
-inline FXmlNode* AppendChild(FXmlNode* Parent, FString const& Name)
+inline bool ShouldDocumentPin(UEdGraphPin* Pin)
 {
-	Parent->AppendChildNode(Name, FString());
-	return Parent->GetChildrenNodes().Last();
+	return !Pin->bHidden;
 }
 
-inline FXmlNode* AppendChildRaw(FXmlNode* Parent, FString const& Name, FString const& TextContent)
+bool FNodeDocsGenerator::GenerateNodeDocs(UK2Node* Node, FNodeProcessingState& State)
 {
-	Parent->AppendChildNode(Name, TextContent);
-	return Parent->GetChildrenNodes().Last();
-}
+	SCOPE_SECONDS_COUNTER(GenerateNodeDocsTime);
+	KANTANDOCGEN_TRACE_SCOPE("NodeXml");
 
-inline FXmlNode* AppendChildCDATA(FXmlNode* Parent, FString const& Name, FString const& TextContent)
-{
-	Parent->AppendChildNode(Name, WrapAsCDATA(TextContent));
-	return Parent->GetChildrenNodes().Last();
-}
+	FDocGenNodeEntry NodeDoc;
+	NodeDoc.Id = State.NodeId;
 
-// For K2 pins only!
-bool ExtractPinInformation(UEdGraphPin* Pin, FString& OutName, FString& OutType, FString& OutDescription)
-{
-	FString Tooltip;
-	Pin->GetOwningNode()->GetPinHoverText(*Pin, Tooltip);
+	FString const DocFilePath = DocGenIntermediate::GetNodePath(OutputDir, State.ClassDoc->Id, NodeDoc.Id);
 
-	if(!Tooltip.IsEmpty())
+	NodeDoc.ShortTitle = State.NodeShortTitle.TrimEnd();
+
+	FString NodeFullTitle = Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
+	auto TargetIdx = NodeFullTitle.Find(TEXT("Target is "), ESearchCase::CaseSensitive);
+	if(TargetIdx != INDEX_NONE)
 	{
-		// @NOTE: This is based on the formatting in UEdGraphSchema_K2::ConstructBasicPinTooltip.
-		// If that is changed, this will fail!
-		
-		auto TooltipPtr = *Tooltip;
+		NodeFullTitle = NodeFullTitle.Left(TargetIdx).TrimEnd();
+	}
+	NodeDoc.FullTitle = NodeFullTitle;
 
-		// Parse name line
-		FParse::Line(&TooltipPtr, OutName);
-		// Parse type line
-		FParse::Line(&TooltipPtr, OutType);
+	FString NodeDesc = Node->GetTooltipText().ToString();
+	TargetIdx = NodeDesc.Find(TEXT("Target is "), ESearchCase::CaseSensitive);
+	if(TargetIdx != INDEX_NONE)
+	{
+		NodeDesc = NodeDesc.Left(TargetIdx).TrimEnd();
+	}
+	NodeDoc.Description = NodeDesc;
+	// Left empty when not generating images
+	NodeDoc.ImagePath = State.ImageFilename.IsEmpty() ? FString() : State.RelImageBasePath / State.ImageFilename;
+	NodeDoc.Category = Node->GetMenuCategory().ToString();
 
-		// Currently there is an empty line here, but FParse::Line seems to gobble up empty lines as part of the previous call.
-		// Anyway, attempting here to deal with this generically in case that weird behaviour changes.
-		while(*TooltipPtr == TEXT('\n'))
+	auto const FunctionDoc = FunctionDocs.FindForNode(Node);
+	for(auto Pin : Node->Pins)
+	{
+		if(ShouldDocumentPin(Pin))
 		{
-			FString Buf;
-			FParse::Line(&TooltipPtr, Buf);
-		}
+			FDocGenParamEntry Param;
+			ExtractPinInformation(Pin, FunctionDoc.Get(), Param.Name, Param.Type, Param.Description);
 
-		// What remains is the description
-		OutDescription = TooltipPtr;
+			if(Pin->Direction == EEdGraphPinDirection::EGPD_Input)
+			{
+				NodeDoc.Inputs.Add(MoveTemp(Param));
+			}
+			else
+			{
+				NodeDoc.Outputs.Add(MoveTemp(Param));
+			}
+		}
 	}
 
-	// @NOTE: Currently overwriting the name and type as suspect this is more robust to future engine changes.
-
-	OutName = Pin->GetDisplayName().ToString();
-	if(OutName.IsEmpty() && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
+	auto& Writer = *XmlWriter;
+	DocGenIntermediate::WriteNode(Writer, DocsTitle, *State.ClassDoc, NodeDoc);
+	if(!Writer.SaveToFile(DocFilePath))
 	{
-		OutName = Pin->Direction == EEdGraphPinDirection::EGPD_Input ? TEXT("In") : TEXT("Out");
+		return false;
 	}
 
-	OutType = UEdGraphSchema_K2::TypeToText(Pin->PinType).ToString();
+	State.ClassDoc->Nodes.Add(FDocGenNodeSummary{ NodeDoc.Id, State.NodeShortTitle });
+	State.ClassDoc->NodeDocs.Add(MoveTemp(NodeDoc));
 
+	Manifest.Nodes.Add(
+		FDocGenManifest::MakeNodeKey(State.ClassDoc->Id, State.NodeId),
+		FDocGenManifest::FNodeRecord{ State.ClassDoc->Id, State.NodeId, State.NodeHash, State.ImageFilename }
+	);
+	
 	return true;
 }
 
-TSharedPtr< FXmlFile > FNodeDocsGenerator::InitIndexXml(FString const& IndexTitle)
+void FNodeDocsGenerator::ReuseNodeDocs(FNodeProcessingState& State)
 {
-	const FString FileTemplate = R"xxx(<?xml version="1.0" encoding="UTF-8"?>
-<root></root>)xxx";
-
-	TSharedPtr< FXmlFile > File = MakeShared< FXmlFile >(FileTemplate, EConstructMethod::ConstructFromBuffer);
-	auto Root = File->GetRootNode();
+	State.ClassDoc->Nodes.Add(FDocGenNodeSummary{ State.NodeId, State.NodeShortTitle });
 
-	AppendChildCDATA(Root, TEXT("display_name"), IndexTitle);
-	AppendChild(Root, TEXT("classes"));
-
-	return File;
+	Manifest.Nodes.Add(
+		FDocGenManifest::MakeNodeKey(State.ClassDoc->Id, State.NodeId),
+		FDocGenManifest::FNodeRecord{ State.ClassDoc->Id, State.NodeId, State.NodeHash, State.ImageFilename }
+	);
 }
 
-TSharedPtr< FXmlFile > FNodeDocsGenerator::InitClassDocXml(UClass* Class)
+bool FNodeDocsGenerator::SaveIndexXml(FString const& OutDir)
 {
-	const FString FileTemplate = R"xxx(<?xml version="1.0" encoding="UTF-8"?>
-<root></root>)xxx";
-
-	TSharedPtr< FXmlFile > File = MakeShared< FXmlFile >(FileTemplate, EConstructMethod::ConstructFromBuffer);
-	auto Root = File->GetRootNode();
-
-	AppendChildCDATA(Root, TEXT("docs_name"), DocsTitle);
-	AppendChildCDATA(Root, TEXT("id"), GetClassDocId(Class));
-	AppendChildCDATA(Root, TEXT("display_name"), FBlueprintEditorUtils::GetFriendlyClassDisplayName(Class).ToString());
-	AppendChild(Root, TEXT("nodes"));
+	if(!bIndexDirty)
+	{
+		return true;
+	}
 
-	return File;
+	auto& Writer = *XmlWriter;
+	DocGenIntermediate::WriteIndex(Writer, DocsTitle, GetClassDocs());
+	return Writer.SaveToFile(DocGenIntermediate::GetIndexPath(OutDir));
 }
 
-bool FNodeDocsGenerator::UpdateIndexDocWithClass(FXmlFile* DocFile, UClass* Class)
+bool FNodeDocsGenerator::SaveClassDocXml(FString const& OutDir)
 {
-	auto ClassId = GetClassDocId(Class);
-	auto Classes = DocFile->GetRootNode()->FindChildNode(TEXT("classes"));
-	auto ClassElem = AppendChild(Classes, TEXT("class"));
-	AppendChildCDATA(ClassElem, TEXT("id"), ClassId);
-	AppendChildCDATA(ClassElem, TEXT("display_name"), FBlueprintEditorUtils::GetFriendlyClassDisplayName(Class).ToString());
-	return true;
-}
+	for(auto const& Entry : ClassDocsMap)
+	{
+		auto const& ClassDoc = *Entry.Value;
+		if(!ClassDoc.bDirty)
+		{
+			continue;
+		}
+
+		auto& Writer = *XmlWriter;
+		DocGenIntermediate::WriteClass(Writer, DocsTitle, ClassDoc);
+		if(!Writer.SaveToFile(DocGenIntermediate::GetClassPath(OutDir, ClassDoc.Id)))
+		{
+			return false;
+		}
+	}
 
-bool FNodeDocsGenerator::UpdateClassDocWithNode(FXmlFile* DocFile, UEdGraphNode* Node)
-{
-	auto NodeId = GetNodeDocId(Node);
-	auto Nodes = DocFile->GetRootNode()->FindChildNode(TEXT("nodes"));
-	auto NodeElem = AppendChild(Nodes, TEXT("node"));
-	AppendChildCDATA(NodeElem, TEXT("id"), NodeId);
-	AppendChildCDATA(NodeElem, TEXT("shorttitle"), Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
 	return true;
 }
 
-inline bool ShouldDocumentPin(UEdGraphPin* Pin)
+TArray< FDocGenClassEntryPtr > FNodeDocsGenerator::GetClassDocs() const
 {
-	return !Pin->bHidden;
+	TArray< FDocGenClassEntryPtr > Result;
+	ClassDocsMap.GenerateValueArray(Result);
+	return Result;
 }
 
-bool FNodeDocsGenerator::GenerateNodeDocs(UK2Node* Node, FNodeProcessingState& State)
+void FNodeDocsGenerator::UpdateHashes()
 {
-	SCOPE_SECONDS_COUNTER(GenerateNodeDocsTime);
+	// Class and index documents only depend on the ids and titles of their entries, so hash just those.
+	FDocGenHashBuilder IndexHash;
+	IndexHash.Add(DocFormatVersion).Add(DocsTitle);
 
-	auto NodeDocsPath = State.ClassDocsPath / TEXT("nodes");
-	FString DocFilePath = NodeDocsPath / (GetNodeDocId(Node) + TEXT(".xml"));
+	auto ClassDocs = GetClassDocs();
+	ClassDocs.Sort([](FDocGenClassEntryPtr const& A, FDocGenClassEntryPtr const& B)
+	{
+		return A->Id.Compare(B->Id, ESearchCase::CaseSensitive) < 0;
+	});
 
-	const FString FileTemplate = R"xxx(<?xml version="1.0" encoding="UTF-8"?>
-<root></root>)xxx";
+	for(auto const& ClassDoc : ClassDocs)
+	{
+		auto Nodes = ClassDoc->Nodes;
+		Nodes.Sort([](FDocGenNodeSummary const& A, FDocGenNodeSummary const& B)
+		{
+			return A.Id.Compare(B.Id, ESearchCase::CaseSensitive) < 0;
+		});
 
-	FXmlFile File(FileTemplate, EConstructMethod::ConstructFromBuffer);
-	auto Root = File.GetRootNode();
-	
-	AppendChildCDATA(Root, TEXT("docs_name"), DocsTitle);
-	// Since we pull these from the class xml file, the entries are already CDATA wrapped
-	AppendChildRaw(Root, TEXT("class_id"), State.ClassDocXml->GetRootNode()->FindChildNode(TEXT("id"))->GetContent());//GetClassDocId(Class));
-	AppendChildRaw(Root, TEXT("class_name"), State.ClassDocXml->GetRootNode()->FindChildNode(TEXT("display_name"))->GetContent());// FBlueprintEditorUtils::GetFriendlyClassDisplayName(Class).ToString());
+		FDocGenHashBuilder ClassHash;
+		ClassHash.Add(DocFormatVersion).Add(DocsTitle).Add(ClassDoc->Id).Add(ClassDoc->DisplayName);
+		for(auto const& Node : Nodes)
+		{
+			ClassHash.Add(Node.Id).Add(Node.ShortTitle);
+		}
 
-	FString NodeShortTitle = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
-	AppendChildCDATA(Root, TEXT("shorttitle"), NodeShortTitle.TrimEnd());
+		auto const Hash = ClassHash.Finalize();
+		auto const ClassXmlPath = DocGenIntermediate::GetClassPath(OutputDir, ClassDoc->Id);
+		ClassDoc->bDirty = PrevManifest.Classes.FindRef(ClassDoc->Id) != Hash || !FPaths::FileExists(ClassXmlPath);
+		Manifest.Classes.Add(ClassDoc->Id, Hash);
 
-	FString NodeFullTitle = Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
-	auto TargetIdx = NodeFullTitle.Find(TEXT("Target is "), ESearchCase::CaseSensitive);
-	if(TargetIdx != INDEX_NONE)
-	{
-		NodeFullTitle = NodeFullTitle.Left(TargetIdx).TrimEnd();
+		IndexHash.Add(ClassDoc->Id).Add(ClassDoc->DisplayName);
 	}
-	AppendChildCDATA(Root, TEXT("fulltitle"), NodeFullTitle);
 
-	FString NodeDesc = Node->GetTooltipText().ToString();
-	TargetIdx = NodeDesc.Find(TEXT("Target is "), ESearchCase::CaseSensitive);
-	if(TargetIdx != INDEX_NONE)
+	Manifest.IndexHash = IndexHash.Finalize();
+	bIndexDirty = Manifest.IndexHash != PrevManifest.IndexHash || !FPaths::FileExists(DocGenIntermediate::GetIndexPath(OutputDir));
+
+	// Anything documented last time but not this time needs removing
+	StaleNodes.Reset();
+	for(auto const& Entry : PrevManifest.Nodes)
 	{
-		NodeDesc = NodeDesc.Left(TargetIdx).TrimEnd();
+		if(!Manifest.Nodes.Contains(Entry.Key))
+		{
+			StaleNodes.Add(Entry.Value);
+		}
 	}
-	AppendChildCDATA(Root, TEXT("description"), NodeDesc);
-	AppendChildCDATA(Root, TEXT("imgpath"), State.RelImageBasePath / State.ImageFilename);
-	AppendChildCDATA(Root, TEXT("category"), Node->GetMenuCategory().ToString());
-	
-	auto Inputs = AppendChild(Root, TEXT("inputs"));
-	for(auto Pin : Node->Pins)
+
+	StaleClasses.Reset();
+	for(auto const& Entry : PrevManifest.Classes)
 	{
-		if(Pin->Direction == EEdGraphPinDirection::EGPD_Input)
+		if(!Manifest.Classes.Contains(Entry.Key))
 		{
-			if(ShouldDocumentPin(Pin))
-			{
-				auto Input = AppendChild(Inputs, TEXT("param"));
+			StaleClasses.Add(Entry.Key);
+		}
+	}
 
-				FString PinName, PinType, PinDesc;
-				ExtractPinInformation(Pin, PinName, PinType, PinDesc);
+	int32 NumDirtyClasses = 0;
+	for(auto const& ClassDoc : ClassDocs)
+	{
+		NumDirtyClasses += ClassDoc->bDirty ? 1 : 0;
+	}
 
-				AppendChildCDATA(Input, TEXT("name"), PinName);
-				AppendChildCDATA(Input, TEXT("type"), PinType);
-				AppendChildCDATA(Input, TEXT("description"), PinDesc);
-			}
-		}
+	UE_LOG(LogKantanDocGen, Log, TEXT("%i of %i classes changed, %i stale nodes and %i stale classes to remove."),
+		NumDirtyClasses, ClassDocs.Num(), StaleNodes.Num(), StaleClasses.Num());
+}
+
+void FNodeDocsGenerator::RemoveStaleIntermediates(FString const& OutDir)
+{
+	auto& FileManager = IFileManager::Get();
+
+	for(auto const& ClassId : StaleClasses)
+	{
+		FileManager.DeleteDirectory(*(OutDir / ClassId), false, true);
 	}
 
-	auto Outputs = AppendChild(Root, TEXT("outputs"));
-	for(auto Pin : Node->Pins)
+	for(auto const& Record : StaleNodes)
 	{
-		if(Pin->Direction == EEdGraphPinDirection::EGPD_Output)
-		{
-			if(ShouldDocumentPin(Pin))
-			{
-				auto Output = AppendChild(Outputs, TEXT("param"));
+		FileManager.Delete(*DocGenIntermediate::GetNodePath(OutDir, Record.ClassId, Record.NodeId), false, false, true);
+	}
 
-				FString PinName, PinType, PinDesc;
-				ExtractPinInformation(Pin, PinName, PinType, PinDesc);
+	// Shared images can only go once nothing references them
+	auto const ReferencedImages = GetReferencedImages();
 
-				AppendChildCDATA(Output, TEXT("name"), PinName);
-				AppendChildCDATA(Output, TEXT("type"), PinType);
-				AppendChildCDATA(Output, TEXT("description"), PinDesc);
-			}
+	TArray< FString > ImageFiles;
+	FileManager.FindFiles(ImageFiles, *(GetImageDir() / TEXT("*")), true, false);
+	for(auto const& ImageFile : ImageFiles)
+	{
+		if(!ReferencedImages.Contains(ImageFile))
+		{
+			FileManager.Delete(*(GetImageDir() / ImageFile), false, false, true);
 		}
 	}
+}
 
-	if(!File.Save(DocFilePath))
+TSet< FString > FNodeDocsGenerator::GetReferencedImages() const
+{
+	TSet< FString > Result;
+	for(auto const& Entry : Manifest.Nodes)
 	{
-		return false;
+		if(!Entry.Value.ImageFilename.IsEmpty())
+		{
+			Result.Add(Entry.Value.ImageFilename);
+		}
 	}
+	return Result;
+}
 
-	if(!UpdateClassDocWithNode(State.ClassDocXml.Get(), Node))
+bool FNodeDocsGenerator::SaveManifest()
+{
+	if(!Manifest.Save(GetManifestPath()))
 	{
+		UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to save doc gen manifest, next run will regenerate everything."));
 		return false;
 	}
-	
+
 	return true;
 }
 
-bool FNodeDocsGenerator::SaveIndexXml(FString const& OutDir)
+FString FNodeDocsGenerator::GetManifestPath() const
 {
-	auto Path = OutDir / TEXT("index.xml");
-	IndexXml->Save(Path);
+	return OutputDir / TEXT("manifest.json");
+}
 
-	return true;
+FString FNodeDocsGenerator::GetImageDir() const
+{
+	return DocGenIntermediate::GetImageDir(OutputDir);
 }
 
-bool FNodeDocsGenerator::SaveClassDocXml(FString const& OutDir)
+FString FNodeDocsGenerator::ComputeNodeHash(UK2Node* Node, UBlueprintNodeSpawner* Spawner, FDocGenClassEntry const& ClassDoc) const
 {
-	for(auto const& Entry : ClassDocsMap)
+	FDocGenHashBuilder Hash;
+
+	Hash.Add(DocFormatVersion)
+		.Add(FEngineVersion::Current().ToString())
+		.Add(DocsTitle)
+		.Add(ClassDoc.Id)
+		.Add(ClassDoc.DisplayName);
+
+	// Spawner
+	Hash.Add(Spawner->GetClass()->GetPathName())
+		.Add(Spawner->NodeClass ? Spawner->NodeClass->GetPathName() : FString())
+		.Add(Spawner->GetSpawnerSignature().ToString());
+
+	// Function signature, if there is one
+	UFunction const* Function = nullptr;
+	if(auto FuncNode = Cast< UK2Node_CallFunction >(Node))
+	{
+		Function = FuncNode->GetTargetFunction();
+	}
+	else if(auto FuncSpawner = Cast< UBlueprintFunctionNodeSpawner >(Spawner))
 	{
-		auto ClassId = GetClassDocId(Entry.Key.Get());
-		auto Path = OutDir / ClassId / (ClassId + TEXT(".xml"));
-		Entry.Value->Save(Path);
+		Function = FuncSpawner->GetFunction();
 	}
 
-	return true;
+	if(Function)
+	{
+		Hash.Add(Function->GetPathName())
+			.Add((int64)Function->FunctionFlags);
+
+		for(TFieldIterator< FProperty > It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+		{
+			Hash.Add(It->GetFName())
+				.Add(It->GetCPPType())
+				.Add((int64)It->PropertyFlags);
+		}
+	}
+
+	// Everything that ends up in the generated docs
+	Hash.Add(Node->GetNodeTitle(ENodeTitleType::ListView))
+		.Add(Node->GetNodeTitle(ENodeTitleType::FullTitle))
+		.Add(Node->GetTooltipText())
+		.Add(Node->GetMenuCategory());
+
+	// Pin descriptions come from the function docs when there are any, otherwise from each pin's hover text
+	auto const FunctionDoc = FunctionDocs.FindForNode(Node);
+	for(auto Pin : Node->Pins)
+	{
+		FString PinDoc;
+		if(FunctionDoc.IsValid())
+		{
+			auto Doc = FunctionDoc->FindPinDoc(Pin->PinName);
+			PinDoc = Doc ? *Doc : FString();
+		}
+		else
+		{
+			Node->GetPinHoverText(*Pin, PinDoc);
+		}
+
+		Hash.Add(Pin->PinName)
+			.Add(Pin->GetDisplayName())
+			.Add((int64)Pin->Direction)
+			.Add((int64)Pin->bHidden)
+			.Add(UEdGraphSchema_K2::TypeToText(Pin->PinType))
+			.Add(Pin->DefaultValue)
+			.Add(PinDoc);
+	}
+
+	return Hash.Finalize();
 }
 
 
@@ -476,11 +682,6 @@ FString FNodeDocsGenerator::GetNodeDocId(UEdGraphNode* Node)
 }
 
 
-#include "BlueprintVariableNodeSpawner.h"
-#include "BlueprintDelegateNodeSpawner.h"
-#include "K2Node_CallFunction.h"
-#include "K2Node_DynamicCast.h"
-
 /*
 This takes a graph node object and attempts to map it to the class which the node conceptually belong to.
 If there is no special mapping for the node, the function determines the class from the source object.
@@ -512,82 +713,3 @@ UClass* FNodeDocsGenerator::MapToAssociatedClass(UK2Node* NodeInst, UObject* Sou
 	}
 }
 
-bool FNodeDocsGenerator::IsSpawnerDocumentable(UBlueprintNodeSpawner* Spawner, bool bIsBlueprint)
-{
-	// Spawners of or deriving from the following classes will be excluded
-	static const TSubclassOf< UBlueprintNodeSpawner > ExcludedSpawnerClasses[] = {
-		UBlueprintVariableNodeSpawner::StaticClass(),
-		UBlueprintDelegateNodeSpawner::StaticClass(),
-		UBlueprintBoundNodeSpawner::StaticClass(),
-		UBlueprintComponentNodeSpawner::StaticClass(),
-	};
-
-	// Spawners of or deriving from the following classes will be excluded in a blueprint context
-	static const TSubclassOf< UBlueprintNodeSpawner > BlueprintOnlyExcludedSpawnerClasses[] = {
-		UBlueprintEventNodeSpawner::StaticClass(),
-	};
-
-	// Spawners for nodes of these types (or their subclasses) will be excluded
-	static const TSubclassOf< UK2Node > ExcludedNodeClasses[] = {
-		UK2Node_DynamicCast::StaticClass(),
-		UK2Node_Message::StaticClass(),
-	};
-
-	// Function spawners for functions with any of the following metadata tags will also be excluded
-	static const FName ExcludedFunctionMeta[] = {
-		TEXT("BlueprintAutocast")
-	};
-
-	static const uint32 PermittedAccessSpecifiers = (FUNC_Public | FUNC_Protected);
-
-
-	for(auto ExclSpawnerClass : ExcludedSpawnerClasses)
-	{
-		if(Spawner->IsA(ExclSpawnerClass))
-		{
-			return false;
-		}
-	}
-
-	if(bIsBlueprint)
-	{
-		for(auto ExclSpawnerClass : BlueprintOnlyExcludedSpawnerClasses)
-		{
-			if(Spawner->IsA(ExclSpawnerClass))
-			{
-				return false;
-			}
-		}
-	}
-
-	for(auto ExclNodeClass : ExcludedNodeClasses)
-	{
-		if(Spawner->NodeClass->IsChildOf(ExclNodeClass))
-		{
-			return false;
-		}
-	}
-
-	if(auto FuncSpawner = Cast< UBlueprintFunctionNodeSpawner >(Spawner))
-	{
-		auto Func = FuncSpawner->GetFunction();
-
-		// @NOTE: We exclude based on access level, but only if this is not a spawner for a blueprint event
-		// (custom events do not have any access specifiers)
-		if((Func->FunctionFlags & FUNC_BlueprintEvent) == 0 && (Func->FunctionFlags & PermittedAccessSpecifiers) == 0)
-		{
-			return false;
-		}
-
-		for(auto const& Meta : ExcludedFunctionMeta)
-		{
-			if(Func->HasMetaData(Meta))
-			{
-				return false;
-			}
-		}
-	}
-
-	return true;
-}
-
@@ -9,76 +9,147 @@
 #include "Modules/ModuleManager.h"
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "DocGenModel.h"
+#include "DocGenManifest.h"
+#include "DocGenSettings.h"
+#include "DocGenFunctionDocCache.h"
 
 
 class UClass;
 class UBlueprint;
 class UEdGraph;
 class UEdGraphNode;
+class UEdGraphPin;
 class UK2Node;
 class UBlueprintNodeSpawner;
-class FXmlFile;
+class FDocGenImageWriter;
+class IDocGenNodeImageBackend;
+class FDocGenXmlWriter;
 
 class FNodeDocsGenerator
 {
 public:
-	FNodeDocsGenerator()
-	{}
+	/** MaxPendingImageWrites bounds the number of node images being encoded in the background at once (<= 0 for automatic) */
+	FNodeDocsGenerator(int32 MaxPendingImageWrites = 0);
 	~FNodeDocsGenerator();
 
 public:
 	struct FNodeProcessingState
 	{
-		TSharedPtr< FXmlFile > ClassDocXml;
+		FDocGenClassEntryPtr ClassDoc;
 		FString ClassDocsPath;
 		FString RelImageBasePath;
 		FString ImageFilename;
+		FString NodeId;
+		FString NodeShortTitle;
+		FString NodeHash;
+		bool bUpToDate;	// Docs from a previous run can be reused as is
 
 		FNodeProcessingState():
-			ClassDocXml()
+			ClassDoc()
 			, ClassDocsPath()
 			, RelImageBasePath()
 			, ImageFilename()
+			, NodeId()
+			, NodeShortTitle()
+			, NodeHash()
+			, bUpToDate(false)
 		{}
 	};
 
+	struct FGenerationStats
+	{
+		double NodeImageTime = 0.0;
+		double NodeDocsTime = 0.0;
+		double ImageEncodeTime = 0.0;	// Summed across pool threads
+		int32 NumImagesEncoded = 0;
+		int32 NumImagesReused = 0;
+		int64 ImageBytes = 0;			// Only counted once image writes are flushed
+		int64 XmlBytes = 0;
+	};
+
 public:
 	/** Callable only from game thread */
-	bool GT_Init(FString const& InDocsTitle, FString const& InOutputDir, UClass* BlueprintContextClass = AActor::StaticClass());
+	bool GT_Init(FString const& InDocsTitle, FString const& InOutputDir, UClass* BlueprintContextClass = AActor::StaticClass(), bool bIncremental = false, bool bInGenerateImages = true, EDocGenImageFormat ImageFormat = EDocGenImageFormat::Png);
+	/** Spawner should already have passed FDocGenSpawnerFilter */
 	UK2Node* GT_InitializeForSpawner(UBlueprintNodeSpawner* Spawner, UObject* SourceObject, FNodeProcessingState& OutState);
+	/** Takes a node spawned by GT_InitializeForSpawner back out of the graph, once it's no longer needed. It's freed by the next GC. */
+	void GT_RemoveNode(UEdGraphNode* Node);
 	bool GT_Finalize(FString OutputPath);
 	/**/
 
 	/** Callable from background thread */
-	bool GenerateNodeImage(UEdGraphNode* Node, FNodeProcessingState& State);
+	bool GenerateNodeImage(UEdGraphNode* Node, FNodeProcessingState& State);	// Only if images were enabled in GT_Init
 	bool GenerateNodeDocs(UK2Node* Node, FNodeProcessingState& State);
+	/** Use in place of generating image/docs for a node that is up to date */
+	void ReuseNodeDocs(FNodeProcessingState& State);
+	/** Waits for all node images to be written, must be called before GT_Finalize. Returns false if any failed. */
+	bool FlushImageWrites();
+	/**/
+
+	/** Only valid once generation is finished (after GT_Finalize) */
+	FString const& GetDocsTitle() const { return DocsTitle; }
+	TArray< FDocGenClassEntryPtr > GetClassDocs() const;
+	bool IsIndexDirty() const { return bIndexDirty; }
+	TArray< FDocGenManifest::FNodeRecord > const& GetStaleNodes() const { return StaleNodes; }
+	TArray< FString > const& GetStaleClasses() const { return StaleClasses; }
+	TSet< FString > GetReferencedImages() const;
+
+	/** Background thread */
+	FGenerationStats GetStats() const;
+
+	/** Name, type and description of a K2 node pin. The description comes from FunctionDoc when the node wraps a function and documents the pin, otherwise it's parsed from the pin's hover text. */
+	static bool ExtractPinInformation(UEdGraphPin* Pin, FDocGenFunctionDoc const* FunctionDoc, FString& OutName, FString& OutType, FString& OutDescription);
+
+	/** Records the hashes of this run, to be called once output has been successfully produced */
+	bool SaveManifest();
 	/**/
 
 protected:
 	void CleanUp();
-	TSharedPtr< FXmlFile > InitIndexXml(FString const& IndexTitle);
-	TSharedPtr< FXmlFile > InitClassDocXml(UClass* Class);
-	bool UpdateIndexDocWithClass(FXmlFile* DocFile, UClass* Class);
-	bool UpdateClassDocWithNode(FXmlFile* DocFile, UEdGraphNode* Node);
 	bool SaveIndexXml(FString const& OutDir);
 	bool SaveClassDocXml(FString const& OutDir);
+	void UpdateHashes();
+	void RemoveStaleIntermediates(FString const& OutDir);
+	FString GetManifestPath() const;
+	FString GetImageDir() const;
+
+	FString ComputeNodeHash(UK2Node* Node, UBlueprintNodeSpawner* Spawner, FDocGenClassEntry const& ClassDoc) const;
 
 	static void AdjustNodeForSnapshot(UEdGraphNode* Node);
 	static FString GetClassDocId(UClass* Class);
 	static FString GetNodeDocId(UEdGraphNode* Node);
 	static UClass* MapToAssociatedClass(UK2Node* NodeInst, UObject* Source);
-	static bool IsSpawnerDocumentable(UBlueprintNodeSpawner* Spawner, bool bIsBlueprint);
 
 protected:
 	TWeakObjectPtr< UBlueprint > DummyBP;
 	TWeakObjectPtr< UEdGraph > Graph;
-	TSharedPtr< class SGraphPanel > GraphPanel;
+	TUniquePtr< IDocGenNodeImageBackend > ImageBackend;
+	TUniquePtr< FDocGenImageWriter > ImageWriter;
+	// Reused for every xml document written, only ever used from one thread at a time
+	TUniquePtr< FDocGenXmlWriter > XmlWriter;
+	// Parsed parameter docs, shared by all nodes wrapping the same function
+	mutable FDocGenFunctionDocCache FunctionDocs;
 
 	FString DocsTitle;
-	TSharedPtr< FXmlFile > IndexXml;
-	TMap< TWeakObjectPtr< UClass >, TSharedPtr< FXmlFile > > ClassDocsMap;
+	TMap< TWeakObjectPtr< UClass >, FDocGenClassEntryPtr > ClassDocsMap;
 
 	FString OutputDir;
+	bool bGenerateImages = true;
+
+	// Hashes from the previous run (game thread), and those for this run (background thread until finalization)
+	FDocGenManifest PrevManifest;
+	FDocGenManifest Manifest;
+	bool bIndexDirty = true;
+	TArray< FDocGenManifest::FNodeRecord > StaleNodes;
+	TArray< FString > StaleClasses;
+
+	// Node images are stored once per unique image, named by a hash of their pixels (background thread)
+	TSet< FString > KnownImages;
+	int32 NumEncodedImages = 0;
+	int32 NumDuplicateImages = 0;
+	TArray< FString > PendingImagePaths;
+	int64 WrittenImageBytes = 0;
 
 public:
 	//
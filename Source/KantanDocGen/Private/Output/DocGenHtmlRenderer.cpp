@@ -0,0 +1,385 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenHtmlRenderer.h"
+#include "KantanDocGenLog.h"
+#include "KantanDocGenTrace.h"
+#include "HAL/FileManager.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Async/ParallelFor.h"
+#include "Async/Async.h"
+#include "Interfaces/IPluginManager.h"
+
+
+namespace
+{
+	FString EscapeHtml(FString const& InString)
+	{
+		return InString
+			.Replace(TEXT("&"), TEXT("&amp;"))
+			.Replace(TEXT("<"), TEXT("&lt;"))
+			.Replace(TEXT(">"), TEXT("&gt;"))
+			.Replace(TEXT("\""), TEXT("&quot;"))
+			;
+	}
+
+	// Equivalent of the xslt text() template: trims surrounding whitespace and turns newlines into line breaks.
+	FString FormatText(FString const& InString)
+	{
+		FString Text = InString.Replace(TEXT("\r\n"), TEXT("\n")).TrimStartAndEnd();
+		return EscapeHtml(Text).Replace(TEXT("\n"), TEXT("<br>"));
+	}
+
+	FString BeginPage(FString const& Title, FString const& StylesheetHref)
+	{
+		FString Html;
+		Html += TEXT("<html>\n");
+		Html += TEXT("\t<head>\n");
+		Html += TEXT("\t\t<meta http-equiv=\"Content-Type\" content=\"text/html; charset=UTF-8\">\n");
+		Html += FString::Printf(TEXT("\t\t<title>%s</title>\n"), *EscapeHtml(Title));
+		Html += FString::Printf(TEXT("\t\t<link rel=\"stylesheet\" type=\"text/css\" href=\"%s\">\n"), *StylesheetHref);
+		Html += TEXT("\t</head>\n");
+		Html += TEXT("\t<body>\n");
+		Html += TEXT("\t\t<div id=\"content_container\">\n");
+		return Html;
+	}
+
+	void EndPage(FString& Html)
+	{
+		Html += TEXT("\t\t</div>\n");
+		Html += TEXT("\t</body>\n");
+		Html += TEXT("</html>\n");
+	}
+
+	void AppendNavLink(FString& Html, FString const& Text, FString const& Href = FString())
+	{
+		if(Href.IsEmpty())
+		{
+			Html += FString::Printf(TEXT("\t\t\t<a class=\"navbar_style\">%s</a>\n"), *EscapeHtml(Text));
+		}
+		else
+		{
+			Html += FString::Printf(TEXT("\t\t\t<a class=\"navbar_style\" href=\"%s\">%s</a>\n"), *EscapeHtml(Href), *EscapeHtml(Text));
+		}
+	}
+
+	void AppendNavSeparator(FString& Html)
+	{
+		Html += TEXT("\t\t\t<a class=\"navbar_style\">&gt;</a>\n");
+	}
+
+	void AppendParams(FString& Html, FString const& Heading, TArray< FDocGenParamEntry > const& Params)
+	{
+		Html += FString::Printf(TEXT("\t\t\t<h3 class=\"title_style\">%s</h3>\n"), *Heading);
+		Html += TEXT("\t\t\t<table>\n");
+		Html += TEXT("\t\t\t\t<colgroup>\n\t\t\t\t\t<col width=\"25%\">\n\t\t\t\t\t<col width=\"75%\">\n\t\t\t\t</colgroup>\n");
+		Html += TEXT("\t\t\t\t<tbody>\n");
+		for(auto const& Param : Params)
+		{
+			Html += TEXT("\t\t\t\t\t<tr>\n");
+			Html += TEXT("\t\t\t\t\t\t<td>\n");
+			Html += FString::Printf(TEXT("\t\t\t\t\t\t\t<div class=\"param_name title_style\">%s</div>\n"), *FormatText(Param.Name));
+			Html += FString::Printf(TEXT("\t\t\t\t\t\t\t<div class=\"param_type\">%s</div>\n"), *FormatText(Param.Type));
+			Html += TEXT("\t\t\t\t\t\t</td>\n");
+			Html += FString::Printf(TEXT("\t\t\t\t\t\t<td>%s</td>\n"), *FormatText(Param.Description));
+			Html += TEXT("\t\t\t\t\t</tr>\n");
+		}
+		Html += TEXT("\t\t\t\t</tbody>\n");
+		Html += TEXT("\t\t\t</table>\n");
+	}
+
+	// Xslt sorts use codepoint collation, so avoid FString's case insensitive operator<
+	inline bool CodepointLess(FString const& A, FString const& B)
+	{
+		return A.Compare(B, ESearchCase::CaseSensitive) < 0;
+	}
+}
+
+
+FDocGenHtmlRenderer::FDocGenHtmlRenderer(
+	FString const& InDocsTitle,
+	FString const& InIntermediateDir,
+	FString const& InOutputDir
+):
+	DocsTitle(InDocsTitle)
+	, IntermediateDir(InIntermediateDir)
+	, OutputDir(InOutputDir)
+	, bPendingRenderFailed(false)
+{}
+
+FDocGenHtmlRenderer::~FDocGenHtmlRenderer()
+{
+	// Pending renders reference this object
+	WaitForPendingRenders();
+}
+
+FString FDocGenHtmlRenderer::GetDefaultStylesheetPath()
+{
+	auto Plugin = IPluginManager::Get().FindPlugin(TEXT("KantanDocGen"));
+	if(!Plugin.IsValid())
+	{
+		UE_LOG(LogKantanDocGen, Error, TEXT("Failed to locate plugin info"));
+		return FString();
+	}
+
+	return Plugin->GetBaseDir() / TEXT("ThirdParty") / TEXT("KantanDocGenTool") / TEXT("css") / TEXT("bpdoc.css");
+}
+
+bool FDocGenHtmlRenderer::PrepareOutput(FString const& StylesheetPath, bool bCleanOutput)
+{
+	auto& FileManager = IFileManager::Get();
+
+	if(bCleanOutput && FileManager.DirectoryExists(*OutputDir))
+	{
+		if(!FileManager.DeleteDirectory(*OutputDir, false, true))
+		{
+			UE_LOG(LogKantanDocGen, Error, TEXT("Failed to clean output directory '%s'"), *OutputDir);
+			return false;
+		}
+	}
+
+	if(!FileManager.MakeDirectory(*OutputDir, true))
+	{
+		UE_LOG(LogKantanDocGen, Error, TEXT("Failed to create output directory '%s'"), *OutputDir);
+		return false;
+	}
+
+	if(FileManager.Copy(*(OutputDir / TEXT("css") / FPaths::GetCleanFilename(StylesheetPath)), *StylesheetPath) != COPY_OK)
+	{
+		UE_LOG(LogKantanDocGen, Error, TEXT("Failed to copy stylesheet '%s'"), *StylesheetPath);
+		return false;
+	}
+
+	return true;
+}
+
+bool FDocGenHtmlRenderer::RenderIndex(TArray< FDocGenClassEntryPtr > const& Classes)
+{
+	KANTANDOCGEN_TRACE_SCOPE("HtmlIndex");
+
+	TArray< FDocGenClassEntryPtr > Sorted = Classes;
+	Sorted.StableSort([](FDocGenClassEntryPtr const& A, FDocGenClassEntryPtr const& B)
+	{
+		return CodepointLess(A->DisplayName, B->DisplayName);
+	});
+
+	FString Html = BeginPage(DocsTitle, TEXT("./css/bpdoc.css"));
+	AppendNavLink(Html, DocsTitle);
+	Html += FString::Printf(TEXT("\t\t\t<h1 class=\"title_style\">%s</h1>\n"), *EscapeHtml(DocsTitle));
+	Html += TEXT("\t\t\t<h2 class=\"title_style\">Classes</h2>\n");
+	Html += TEXT("\t\t\t<table>\n\t\t\t\t<tbody>\n");
+	for(auto const& ClassDoc : Sorted)
+	{
+		Html += FString::Printf(TEXT("\t\t\t\t\t<tr>\n\t\t\t\t\t\t<td><a href=\"./%s/%s.html\">%s</a></td>\n\t\t\t\t\t</tr>\n"),
+			*EscapeHtml(ClassDoc->Id), *EscapeHtml(ClassDoc->Id), *FormatText(ClassDoc->DisplayName));
+	}
+	Html += TEXT("\t\t\t\t</tbody>\n\t\t\t</table>\n");
+	EndPage(Html);
+
+	return SavePage(Html, OutputDir / TEXT("index.html"));
+}
+
+bool FDocGenHtmlRenderer::RenderClass(FDocGenClassEntry const& ClassDoc)
+{
+	KANTANDOCGEN_TRACE_SCOPE("HtmlClass");
+
+	auto const ClassOutputDir = OutputDir / ClassDoc.Id;
+	bool bSuccess = true;
+
+	for(auto const& NodeDoc : ClassDoc.NodeDocs)
+	{
+		bSuccess &= RenderNode(ClassDoc, NodeDoc);
+	}
+
+	if(!ClassDoc.bDirty)
+	{
+		return bSuccess;
+	}
+
+	TArray< FDocGenNodeSummary > Sorted = ClassDoc.Nodes;
+	Sorted.StableSort([](FDocGenNodeSummary const& A, FDocGenNodeSummary const& B)
+	{
+		return CodepointLess(A.ShortTitle, B.ShortTitle);
+	});
+
+	FString Html = BeginPage(ClassDoc.DisplayName, TEXT("../css/bpdoc.css"));
+	AppendNavLink(Html, DocsTitle, TEXT("../index.html"));
+	AppendNavSeparator(Html);
+	AppendNavLink(Html, ClassDoc.DisplayName);
+	Html += FString::Printf(TEXT("\t\t\t<h1 class=\"title_style\">%s</h1>\n"), *EscapeHtml(ClassDoc.DisplayName));
+	Html += TEXT("\t\t\t<h2 class=\"title_style\">Nodes</h2>\n");
+	Html += TEXT("\t\t\t<table>\n\t\t\t\t<tbody>\n");
+	for(auto const& NodeSummary : Sorted)
+	{
+		Html += FString::Printf(TEXT("\t\t\t\t\t<tr>\n\t\t\t\t\t\t<td><a href=\"./nodes/%s.html\">%s</a></td>\n\t\t\t\t\t</tr>\n"),
+			*EscapeHtml(NodeSummary.Id), *FormatText(NodeSummary.ShortTitle));
+	}
+	Html += TEXT("\t\t\t\t</tbody>\n\t\t\t</table>\n");
+	EndPage(Html);
+
+	bSuccess &= SavePage(Html, ClassOutputDir / (ClassDoc.Id + TEXT(".html")));
+
+	return bSuccess;
+}
+
+bool FDocGenHtmlRenderer::RenderNode(FDocGenClassEntry const& ClassDoc, FDocGenNodeEntry const& NodeDoc)
+{
+	KANTANDOCGEN_TRACE_SCOPE("HtmlNode");
+
+	FString Html = BeginPage(NodeDoc.ShortTitle, TEXT("../../css/bpdoc.css"));
+	AppendNavLink(Html, DocsTitle, TEXT("../../index.html"));
+	AppendNavSeparator(Html);
+	AppendNavLink(Html, ClassDoc.DisplayName, TEXT("../") + ClassDoc.Id + TEXT(".html"));
+	AppendNavSeparator(Html);
+	AppendNavLink(Html, NodeDoc.ShortTitle);
+
+	Html += FString::Printf(TEXT("\t\t\t<h1 class=\"title_style\">%s</h1>\n"), *FormatText(NodeDoc.ShortTitle));
+	Html += FString::Printf(TEXT("\t\t\t<p>%s</p>\n"), *FormatText(NodeDoc.Description));
+	if(!NodeDoc.ImagePath.IsEmpty())
+	{
+		Html += FString::Printf(TEXT("\t\t\t<img src=\"%s\">\n"), *EscapeHtml(NodeDoc.ImagePath.TrimStartAndEnd()));
+	}
+	AppendParams(Html, TEXT("Inputs"), NodeDoc.Inputs);
+	AppendParams(Html, TEXT("Outputs"), NodeDoc.Outputs);
+	EndPage(Html);
+
+	return SavePage(Html, OutputDir / ClassDoc.Id / TEXT("nodes") / (NodeDoc.Id + TEXT(".html")));
+}
+
+void FDocGenHtmlRenderer::RenderNodesAsync(FDocGenClassEntryPtr ClassDoc, TArray< FDocGenNodeEntry > NodeDocs)
+{
+	// Drop any renders which have already finished, so this doesn't grow over the run
+	for(int32 Idx = PendingRenders.Num() - 1; Idx >= 0; --Idx)
+	{
+		if(PendingRenders[Idx].IsReady())
+		{
+			bPendingRenderFailed |= !PendingRenders[Idx].Get();
+			PendingRenders.RemoveAtSwap(Idx, 1, false);
+		}
+	}
+	TRACE_COUNTER_SET(KantanDocGen_PendingHtmlRenders, PendingRenders.Num() + 1);
+
+	PendingRenders.Add(Async(EAsyncExecution::ThreadPool, [this, ClassDoc, NodeDocs = MoveTemp(NodeDocs)]
+	{
+		bool bSuccess = true;
+		for(auto const& NodeDoc : NodeDocs)
+		{
+			bSuccess &= RenderNode(*ClassDoc, NodeDoc);
+		}
+		return bSuccess;
+	}));
+}
+
+bool FDocGenHtmlRenderer::WaitForPendingRenders()
+{
+	for(auto& Render : PendingRenders)
+	{
+		bPendingRenderFailed |= !Render.Get();
+	}
+	PendingRenders.Reset();
+	TRACE_COUNTER_SET(KantanDocGen_PendingHtmlRenders, 0);
+
+	bool const bSuccess = !bPendingRenderFailed;
+	bPendingRenderFailed = false;
+	return bSuccess;
+}
+
+bool FDocGenHtmlRenderer::RenderAll(TArray< FDocGenClassEntryPtr > const& Classes, bool bRenderIndex)
+{
+	FThreadSafeBool bFailed = false;
+
+	ParallelFor(Classes.Num(), [&](int32 Index)
+	{
+		if(!RenderClass(*Classes[Index]))
+		{
+			bFailed = true;
+		}
+	});
+
+	if(bRenderIndex && !RenderIndex(Classes))
+	{
+		bFailed = true;
+	}
+
+	return !bFailed;
+}
+
+bool FDocGenHtmlRenderer::SyncImages(TSet< FString > const& ImageFilenames)
+{
+	KANTANDOCGEN_TRACE_SCOPE("SyncImages");
+
+	auto& FileManager = IFileManager::Get();
+	auto const SourceDir = IntermediateDir / TEXT("img");
+	auto const DestDir = OutputDir / TEXT("img");
+
+	TArray< FString > Existing;
+	FileManager.FindFiles(Existing, *(DestDir / TEXT("*.*")), true, false);
+	for(auto const& Filename : Existing)
+	{
+		if(!ImageFilenames.Contains(Filename))
+		{
+			FileManager.Delete(*(DestDir / Filename), false, false, true);
+		}
+	}
+
+	// Images are named by content, so any already in the output are up to date
+	TSet< FString > const ExistingSet(Existing);
+	TArray< FString > ToCopy;
+	for(auto const& Filename : ImageFilenames)
+	{
+		if(!ExistingSet.Contains(Filename))
+		{
+			ToCopy.Add(Filename);
+		}
+	}
+
+	FThreadSafeBool bFailed = false;
+	ParallelFor(ToCopy.Num(), [&](int32 Index)
+	{
+		auto const SourcePath = SourceDir / ToCopy[Index];
+		if(IFileManager::Get().Copy(*(DestDir / ToCopy[Index]), *SourcePath) != COPY_OK)
+		{
+			UE_LOG(LogKantanDocGen, Error, TEXT("Failed to copy node image '%s'"), *SourcePath);
+			bFailed = true;
+		}
+	});
+
+	return !bFailed;
+}
+
+void FDocGenHtmlRenderer::RemovePages(TArray< FString > const& ClassIds, TArray< TPair< FString, FString > > const& ClassNodeIds)
+{
+	auto& FileManager = IFileManager::Get();
+
+	for(auto const& ClassId : ClassIds)
+	{
+		FileManager.DeleteDirectory(*(OutputDir / ClassId), false, true);
+	}
+
+	for(auto const& Entry : ClassNodeIds)
+	{
+		FileManager.Delete(*(OutputDir / Entry.Key / TEXT("nodes") / (Entry.Value + TEXT(".html"))), false, false, true);
+	}
+}
+
+bool FDocGenHtmlRenderer::SavePage(FString const& Html, FString const& Path)
+{
+	KANTANDOCGEN_TRACE_SCOPE("FileWrite");
+
+	FTCHARToUTF8 const Utf8(*Html);
+	if(!FFileHelper::SaveArrayToFile(TArrayView< const uint8 >(reinterpret_cast< const uint8* >(Utf8.Get()), Utf8.Length()), *Path))
+	{
+		UE_LOG(LogKantanDocGen, Error, TEXT("Failed to write '%s'"), *Path);
+		return false;
+	}
+
+	BytesWritten.Add(Utf8.Length());
+	return true;
+}
+
+
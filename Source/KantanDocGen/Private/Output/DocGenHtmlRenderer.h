@@ -0,0 +1,74 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "DocGenModel.h"
+#include "Async/Future.h"
+#include "HAL/ThreadSafeCounter64.h"
+
+
+/*
+Renders html documentation directly from the in-memory doc model.
+Produces the same page structure as the xslt transforms used by the external KantanDocGen tool.
+Individual class renders are independent, and safe to run concurrently.
+*/
+class FDocGenHtmlRenderer
+{
+public:
+	FDocGenHtmlRenderer(
+		FString const& InDocsTitle,
+		FString const& InIntermediateDir,
+		FString const& InOutputDir
+	);
+	~FDocGenHtmlRenderer();
+
+public:
+	/** The stylesheet packaged with the plugin, empty if the plugin couldn't be found. */
+	static FString GetDefaultStylesheetPath();
+
+	/** Sets up the output directory and copies across static resources. */
+	bool PrepareOutput(FString const& StylesheetPath, bool bCleanOutput);
+
+	bool RenderIndex(TArray< FDocGenClassEntryPtr > const& Classes);
+	bool RenderClass(FDocGenClassEntry const& ClassDoc);
+	bool RenderNode(FDocGenClassEntry const& ClassDoc, FDocGenNodeEntry const& NodeDoc);
+
+	/** Renders all classes, spread across worker threads, and optionally the index. Class pages are only written for dirty classes. */
+	bool RenderAll(TArray< FDocGenClassEntryPtr > const& Classes, bool bRenderIndex = true);
+
+	/**
+	Renders the given node pages on the thread pool, so that their docs needn't be held until the end of the run.
+	Only the id and display name of the class entry are used. Must be called from a single thread.
+	*/
+	void RenderNodesAsync(FDocGenClassEntryPtr ClassDoc, TArray< FDocGenNodeEntry > NodeDocs);
+	/** Blocks until all async renders have completed. Returns false if any have failed. */
+	bool WaitForPendingRenders();
+
+	/** Makes the output image directory contain exactly the given images from the intermediate image directory. */
+	bool SyncImages(TSet< FString > const& ImageFilenames);
+
+	/** Deletes pages for classes and nodes which are no longer documented. */
+	void RemovePages(TArray< FString > const& ClassIds, TArray< TPair< FString, FString > > const& ClassNodeIds);
+
+	FString const& GetOutputDir() const { return OutputDir; }
+	/** Total size of the html pages written so far */
+	int64 GetBytesWritten() const { return BytesWritten.GetValue(); }
+
+protected:
+	bool SavePage(FString const& Html, FString const& Path);
+
+protected:
+	FString DocsTitle;
+	FString IntermediateDir;
+	FString OutputDir;
+
+	TArray< TFuture< bool > > PendingRenders;
+	bool bPendingRenderFailed;
+	FThreadSafeCounter64 BytesWritten;
+};
+
+
@@ -0,0 +1,106 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenImageWriter.h"
+#include "KantanDocGenLog.h"
+#include "KantanDocGenTrace.h"
+#include "Async/Async.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+
+
+FDocGenImageWriter::FDocGenImageWriter(int32 InMaxInFlight):
+	State(MakeShared< FSharedState, ESPMode::ThreadSafe >())
+{
+	MaxInFlight = InMaxInFlight > 0 ? InMaxInFlight : FMath::Max(GThreadPool ? GThreadPool->GetNumThreads() : 1, 1);
+}
+
+FDocGenImageWriter::~FDocGenImageWriter()
+{
+	Flush();
+}
+
+void FDocGenImageWriter::Enqueue(FString const& Path, TUniqueFunction< bool(FString const&) > Write)
+{
+	// Backpressure: don't let pixel buffers pile up faster than they can be encoded
+	while(State->InFlight.GetValue() >= MaxInFlight)
+	{
+		State->TaskCompleteEvent->Wait();
+	}
+
+	// Not inside the trace macro, which compiles away along with its arguments
+	int32 const NumInFlight = State->InFlight.Increment();
+	TRACE_COUNTER_SET(KantanDocGen_ImageWritesInFlight, NumInFlight);
+
+	// The task captures the shared state rather than this, since it still signals after the decrement that lets Flush return
+	Async(EAsyncExecution::ThreadPool, [TaskState = State, Path, Write = MoveTemp(Write)]
+	{
+		double const StartTime = FPlatformTime::Seconds();
+		bool const bSuccess = Write(Path);
+		if(!bSuccess)
+		{
+			UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to save node image: %s"), *Path);
+		}
+
+		TaskState->OnTaskComplete(bSuccess, FPlatformTime::Seconds() - StartTime);
+	});
+}
+
+int32 FDocGenImageWriter::Flush()
+{
+	while(State->InFlight.GetValue() > 0)
+	{
+		State->TaskCompleteEvent->Wait();
+	}
+
+	FScopeLock Lock(&State->StatsCS);
+	int32 const Failures = State->FailuresSinceFlush;
+	State->FailuresSinceFlush = 0;
+	return Failures;
+}
+
+FDocGenImageWriter::FStats FDocGenImageWriter::GetStats() const
+{
+	FScopeLock Lock(&State->StatsCS);
+	return State->Stats;
+}
+
+
+FDocGenImageWriter::FSharedState::FSharedState()
+{
+	TaskCompleteEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	FailuresSinceFlush = 0;
+}
+
+FDocGenImageWriter::FSharedState::~FSharedState()
+{
+	FPlatformProcess::ReturnSynchEventToPool(TaskCompleteEvent);
+	TaskCompleteEvent = nullptr;
+}
+
+void FDocGenImageWriter::FSharedState::OnTaskComplete(bool bSuccess, double EncodeTime)
+{
+	{
+		FScopeLock Lock(&StatsCS);
+		if(bSuccess)
+		{
+			++Stats.NumWritten;
+		}
+		else
+		{
+			++Stats.NumFailed;
+			++FailuresSinceFlush;
+		}
+		Stats.TotalEncodeTime += EncodeTime;
+	}
+
+	int32 const NumInFlight = InFlight.Decrement();
+	TRACE_COUNTER_SET(KantanDocGen_ImageWritesInFlight, NumInFlight);
+	TaskCompleteEvent->Trigger();
+}
@@ -0,0 +1,70 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/Function.h"
+
+
+class FEvent;
+
+/*
+Encodes and writes node images on the thread pool, with a bound on how many can be in flight at once.
+Enqueue and Flush must be called from a single thread (the doc gen worker).
+*/
+class FDocGenImageWriter
+{
+public:
+	struct FStats
+	{
+		int32 NumWritten = 0;
+		int32 NumFailed = 0;
+		double TotalEncodeTime = 0.0;	// Summed across all pool threads
+	};
+
+public:
+	/** MaxInFlight <= 0 means one per worker thread */
+	FDocGenImageWriter(int32 InMaxInFlight = 0);
+	~FDocGenImageWriter();
+
+public:
+	/** Blocks while the maximum number of writes are already in flight. Write is given Path, and runs on the thread pool. */
+	void Enqueue(FString const& Path, TUniqueFunction< bool(FString const&) > Write);
+
+	/** Blocks until all enqueued writes have completed. Returns the number of failed writes since the last flush. */
+	int32 Flush();
+
+	FStats GetStats() const;
+
+protected:
+	/*
+	Everything a pool task touches on completion. Each task holds a reference, so the writer can be
+	destroyed as soon as Flush sees the last decrement, without racing the completing task's trigger.
+	*/
+	struct FSharedState
+	{
+		FSharedState();
+		~FSharedState();
+
+		void OnTaskComplete(bool bSuccess, double EncodeTime);
+
+		FThreadSafeCounter InFlight;
+		FEvent* TaskCompleteEvent;
+
+		mutable FCriticalSection StatsCS;
+		FStats Stats;
+		int32 FailuresSinceFlush;
+	};
+
+protected:
+	int32 MaxInFlight;
+	TSharedRef< FSharedState, ESPMode::ThreadSafe > State;
+};
+
+
@@ -0,0 +1,178 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenIntermediateFormat.h"
+#include "DocGenXmlWriter.h"
+#include "DocGenXmlReader.h"
+#include "Misc/Paths.h"
+
+
+namespace DocGenIntermediate
+{
+	FString GetIndexPath(FString const& Dir)
+	{
+		return Dir / TEXT("index.xml");
+	}
+
+	FString GetClassPath(FString const& Dir, FString const& ClassId)
+	{
+		return Dir / ClassId / (ClassId + TEXT(".xml"));
+	}
+
+	FString GetNodePath(FString const& Dir, FString const& ClassId, FString const& NodeId)
+	{
+		return Dir / ClassId / TEXT("nodes") / (NodeId + TEXT(".xml"));
+	}
+
+	FString GetImageDir(FString const& Dir)
+	{
+		return Dir / TEXT("img");
+	}
+
+	void WriteIndex(FDocGenXmlWriter& Writer, FString const& DocsTitle, TArray< FDocGenClassEntryPtr > const& Classes)
+	{
+		Writer.BeginDocument();
+		Writer.WriteElement(TEXT("display_name"), DocsTitle);
+		Writer.BeginElement(TEXT("classes"));
+		for(auto const& ClassDoc : Classes)
+		{
+			Writer.BeginElement(TEXT("class"));
+			Writer.WriteElement(TEXT("id"), ClassDoc->Id);
+			Writer.WriteElement(TEXT("display_name"), ClassDoc->DisplayName);
+			Writer.EndElement();
+		}
+		Writer.EndDocument();
+	}
+
+	void WriteClass(FDocGenXmlWriter& Writer, FString const& DocsTitle, FDocGenClassEntry const& ClassDoc)
+	{
+		Writer.BeginDocument();
+		Writer.WriteElement(TEXT("docs_name"), DocsTitle);
+		Writer.WriteElement(TEXT("id"), ClassDoc.Id);
+		Writer.WriteElement(TEXT("display_name"), ClassDoc.DisplayName);
+		Writer.BeginElement(TEXT("nodes"));
+		for(auto const& NodeSummary : ClassDoc.Nodes)
+		{
+			Writer.BeginElement(TEXT("node"));
+			Writer.WriteElement(TEXT("id"), NodeSummary.Id);
+			Writer.WriteElement(TEXT("shorttitle"), NodeSummary.ShortTitle);
+			Writer.EndElement();
+		}
+		Writer.EndDocument();
+	}
+
+	void WriteNode(FDocGenXmlWriter& Writer, FString const& DocsTitle, FDocGenClassEntry const& ClassDoc, FDocGenNodeEntry const& NodeDoc)
+	{
+		Writer.BeginDocument();
+
+		Writer.WriteElement(TEXT("docs_name"), DocsTitle);
+		Writer.WriteElement(TEXT("class_id"), ClassDoc.Id);
+		Writer.WriteElement(TEXT("class_name"), ClassDoc.DisplayName);
+		Writer.WriteElement(TEXT("shorttitle"), NodeDoc.ShortTitle);
+		Writer.WriteElement(TEXT("fulltitle"), NodeDoc.FullTitle);
+		Writer.WriteElement(TEXT("description"), NodeDoc.Description);
+		Writer.WriteElement(TEXT("imgpath"), NodeDoc.ImagePath);
+		Writer.WriteElement(TEXT("category"), NodeDoc.Category);
+
+		auto WriteParams = [&Writer](TCHAR const* Name, TArray< FDocGenParamEntry > const& Params)
+		{
+			Writer.BeginElement(Name);
+			for(auto const& Param : Params)
+			{
+				Writer.BeginElement(TEXT("param"));
+				Writer.WriteElement(TEXT("name"), Param.Name);
+				Writer.WriteElement(TEXT("type"), Param.Type);
+				Writer.WriteElement(TEXT("description"), Param.Description);
+				Writer.EndElement();
+			}
+			Writer.EndElement();
+		};
+		WriteParams(TEXT("inputs"), NodeDoc.Inputs);
+		WriteParams(TEXT("outputs"), NodeDoc.Outputs);
+
+		Writer.EndDocument();
+	}
+
+	bool ReadIndex(FString const& Path, FString& OutDocsTitle, TArray< FDocGenClassEntry >& OutClasses)
+	{
+		FDocGenXmlElement Root;
+		if(!DocGenXmlReader::LoadFile(Path, Root))
+		{
+			return false;
+		}
+
+		OutDocsTitle = Root.GetChildText(TEXT("display_name"));
+		OutClasses.Reset();
+		if(auto Classes = Root.FindChild(TEXT("classes")))
+		{
+			for(auto const& ClassElem : Classes->Children)
+			{
+				FDocGenClassEntry& ClassDoc = OutClasses.AddDefaulted_GetRef();
+				ClassDoc.Id = ClassElem.GetChildText(TEXT("id"));
+				ClassDoc.DisplayName = ClassElem.GetChildText(TEXT("display_name"));
+			}
+		}
+		return true;
+	}
+
+	bool ReadClass(FString const& Path, FDocGenClassEntry& OutClassDoc)
+	{
+		FDocGenXmlElement Root;
+		if(!DocGenXmlReader::LoadFile(Path, Root))
+		{
+			return false;
+		}
+
+		OutClassDoc = FDocGenClassEntry();
+		OutClassDoc.Id = Root.GetChildText(TEXT("id"));
+		OutClassDoc.DisplayName = Root.GetChildText(TEXT("display_name"));
+		if(auto Nodes = Root.FindChild(TEXT("nodes")))
+		{
+			for(auto const& NodeElem : Nodes->Children)
+			{
+				OutClassDoc.Nodes.Add(FDocGenNodeSummary{ NodeElem.GetChildText(TEXT("id")), NodeElem.GetChildText(TEXT("shorttitle")) });
+			}
+		}
+		return true;
+	}
+
+	bool ReadNode(FString const& Path, FDocGenNodeEntry& OutNodeDoc)
+	{
+		FDocGenXmlElement Root;
+		if(!DocGenXmlReader::LoadFile(Path, Root))
+		{
+			return false;
+		}
+
+		OutNodeDoc = FDocGenNodeEntry();
+		OutNodeDoc.ShortTitle = Root.GetChildText(TEXT("shorttitle"));
+		OutNodeDoc.FullTitle = Root.GetChildText(TEXT("fulltitle"));
+		OutNodeDoc.Description = Root.GetChildText(TEXT("description"));
+		OutNodeDoc.ImagePath = Root.GetChildText(TEXT("imgpath"));
+		OutNodeDoc.Category = Root.GetChildText(TEXT("category"));
+
+		auto ReadParams = [&Root](TCHAR const* Name, TArray< FDocGenParamEntry >& OutParams)
+		{
+			if(auto Params = Root.FindChild(Name))
+			{
+				for(auto const& ParamElem : Params->Children)
+				{
+					OutParams.Add(FDocGenParamEntry{
+						ParamElem.GetChildText(TEXT("name")),
+						ParamElem.GetChildText(TEXT("type")),
+						ParamElem.GetChildText(TEXT("description"))
+						});
+				}
+			}
+		};
+		ReadParams(TEXT("inputs"), OutNodeDoc.Inputs);
+		ReadParams(TEXT("outputs"), OutNodeDoc.Outputs);
+
+		return true;
+	}
+}
+
+
@@ -0,0 +1,40 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "DocGenModel.h"
+
+
+class FDocGenXmlWriter;
+
+/*
+Layout and content of the intermediate xml docs, as consumed by the html renderers:
+	<Dir>/index.xml
+	<Dir>/<ClassId>/<ClassId>.xml
+	<Dir>/<ClassId>/nodes/<NodeId>.xml
+	<Dir>/img/<Image>.png|svg
+*/
+namespace DocGenIntermediate
+{
+	FString GetIndexPath(FString const& Dir);
+	FString GetClassPath(FString const& Dir, FString const& ClassId);
+	FString GetNodePath(FString const& Dir, FString const& ClassId, FString const& NodeId);
+	FString GetImageDir(FString const& Dir);
+
+	/** Each of these produces a complete document in the writer, ready to be saved */
+	void WriteIndex(FDocGenXmlWriter& Writer, FString const& DocsTitle, TArray< FDocGenClassEntryPtr > const& Classes);
+	void WriteClass(FDocGenXmlWriter& Writer, FString const& DocsTitle, FDocGenClassEntry const& ClassDoc);
+	void WriteNode(FDocGenXmlWriter& Writer, FString const& DocsTitle, FDocGenClassEntry const& ClassDoc, FDocGenNodeEntry const& NodeDoc);
+
+	/** Only class ids and display names are read from the index */
+	bool ReadIndex(FString const& Path, FString& OutDocsTitle, TArray< FDocGenClassEntry >& OutClasses);
+	bool ReadClass(FString const& Path, FDocGenClassEntry& OutClassDoc);
+	/** The node id isn't part of the document, it comes from the class document entry */
+	bool ReadNode(FString const& Path, FDocGenNodeEntry& OutNodeDoc);
+}
+
+
@@ -0,0 +1,41 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+
+class UEdGraph;
+class UEdGraphNode;
+
+/** A node image produced by a backend, ready to be written out */
+struct FDocGenNodeImage
+{
+	/** Identifies the image content, so that nodes which look identical share a single file */
+	uint64 ContentHash = 0;
+	/** Writes the image to the given path. Runs on the thread pool, so must not touch the node. */
+	TUniqueFunction< bool(FString const& Path) > Write;
+};
+
+/*
+Produces the images of nodes for their doc pages.
+*/
+class IDocGenNodeImageBackend
+{
+public:
+	/** Game thread, given the graph that nodes will be spawned into. */
+	virtual bool GT_Init(UEdGraph* Graph) = 0;
+	/** Doc gen worker thread. */
+	virtual bool RenderNode(UEdGraphNode* Node, FDocGenNodeImage& OutImage) = 0;
+	/** File extension of the images, without the dot. */
+	virtual const TCHAR* GetExtension() const = 0;
+
+	virtual ~IDocGenNodeImageBackend() {}
+};
+
+
@@ -0,0 +1,239 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenSvgImageBackend.h"
+#include "KantanDocGenTrace.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "EdGraphSchema_K2.h"
+#include "Misc/FileHelper.h"
+#include "Hash/CityHash.h"
+
+
+namespace
+{
+	// Layout metrics, roughly matching the graph editor at 1:1 zoom
+	const int32 FontSize = 12;
+	const int32 SubtitleFontSize = 10;
+	const float CharWidth = 6.5f;			// Average advance at FontSize
+	const int32 Padding = 10;
+	const int32 TitleLineHeight = 18;
+	const int32 SubtitleLineHeight = 14;
+	const int32 RowHeight = 24;
+	const int32 IconSize = 12;
+	const int32 IconGap = 6;
+	const int32 ColumnGap = 30;
+	const int32 MinWidth = 100;
+	const int32 CornerRadius = 6;
+
+	struct FSvgPinRow
+	{
+		FString Label;
+		FString DefaultValue;
+		FLinearColor Color;
+		bool bExec;
+		bool bContainer;
+	};
+
+	int32 EstimateTextWidth(FString const& Text, int32 Size = FontSize)
+	{
+		return FMath::CeilToInt(Text.Len() * CharWidth * Size / FontSize);
+	}
+
+	FString ToSvgColor(FLinearColor const& Color)
+	{
+		FColor const C = Color.ToFColor(true);
+		return FString::Printf(TEXT("#%02x%02x%02x"), C.R, C.G, C.B);
+	}
+
+	FString EscapeSvgText(FString const& Text)
+	{
+		FString Result;
+		Result.Reserve(Text.Len());
+		for(TCHAR Ch : Text)
+		{
+			switch(Ch)
+			{
+			case TEXT('&'):	Result += TEXT("&amp;"); break;
+			case TEXT('<'):	Result += TEXT("&lt;"); break;
+			case TEXT('>'):	Result += TEXT("&gt;"); break;
+			case TEXT('"'):	Result += TEXT("&quot;"); break;
+			default:		Result.AppendChar(Ch); break;
+			}
+		}
+		return Result;
+	}
+
+	int32 GetRowWidth(FSvgPinRow const& Row)
+	{
+		int32 Width = IconSize;
+		if(!Row.Label.IsEmpty())
+		{
+			Width += IconGap + EstimateTextWidth(Row.Label);
+		}
+		if(!Row.DefaultValue.IsEmpty())
+		{
+			Width += IconGap + EstimateTextWidth(Row.DefaultValue) + IconGap;
+		}
+		return Width;
+	}
+
+	/** Icons are drawn unconnected (outlined), as in a freshly placed node. (CX, CY) is the icon center. */
+	void AppendPinIcon(FString& Svg, FSvgPinRow const& Row, int32 CX, int32 CY)
+	{
+		int32 const H = IconSize / 2;
+		FString const Color = ToSvgColor(Row.Color);
+		if(Row.bExec)
+		{
+			Svg += FString::Printf(TEXT("<path d=\"M%d %dh%dl%d %dl%d %dh%dz\" fill=\"none\" stroke=\"%s\" stroke-width=\"1.5\"/>"),
+				CX - H, CY - H, H, H, H, -H, H, -H, *Color);
+		}
+		else if(Row.bContainer)
+		{
+			Svg += FString::Printf(TEXT("<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" fill=\"none\" stroke=\"%s\" stroke-width=\"1.5\"/>"),
+				CX - H + 1, CY - H + 1, IconSize - 2, IconSize - 2, *Color);
+		}
+		else
+		{
+			Svg += FString::Printf(TEXT("<circle cx=\"%d\" cy=\"%d\" r=\"%d\" fill=\"none\" stroke=\"%s\" stroke-width=\"1.5\"/>"),
+				CX, CY, H - 1, *Color);
+		}
+	}
+
+	void AppendText(FString& Svg, FString const& Text, int32 X, int32 Y, TCHAR const* Attributes)
+	{
+		Svg += FString::Printf(TEXT("<text x=\"%d\" y=\"%d\"%s>%s</text>"), X, Y, Attributes, *EscapeSvgText(Text));
+	}
+}
+
+
+bool FDocGenSvgImageBackend::RenderNode(UEdGraphNode* Node, FDocGenNodeImage& OutImage)
+{
+	KANTANDOCGEN_TRACE_SCOPE("SvgLayout");
+
+	auto K2Schema = GetDefault< UEdGraphSchema_K2 >();
+
+	TArray< FString > TitleLines;
+	Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString().ParseIntoArrayLines(TitleLines);
+	if(TitleLines.Num() == 0)
+	{
+		TitleLines.Add(FString());
+	}
+
+	TArray< FSvgPinRow > Inputs;
+	TArray< FSvgPinRow > Outputs;
+	bool const bShowAdvanced = Node->AdvancedPinDisplay == ENodeAdvancedPins::Shown;
+	for(auto Pin : Node->Pins)
+	{
+		if(Pin->bHidden || (Pin->bAdvancedView && !bShowAdvanced))
+		{
+			continue;
+		}
+
+		FSvgPinRow Row;
+		Row.bExec = Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec;
+		Row.bContainer = Pin->PinType.IsContainer();
+		Row.Color = Row.bExec ? FLinearColor::White : K2Schema->GetPinTypeColor(Pin->PinType);
+		Row.Label = Pin->GetDisplayName().ToString();
+		if(Pin->Direction == EGPD_Input && !Row.bExec && !Pin->bDefaultValueIsIgnored && !Pin->PinType.IsContainer())
+		{
+			Row.DefaultValue = Pin->GetDefaultAsString();
+		}
+
+		(Pin->Direction == EGPD_Input ? Inputs : Outputs).Add(MoveTemp(Row));
+	}
+
+	// Measure
+	int32 TitleWidth = EstimateTextWidth(TitleLines[0]);
+	for(int32 Idx = 1; Idx < TitleLines.Num(); ++Idx)
+	{
+		TitleWidth = FMath::Max(TitleWidth, EstimateTextWidth(TitleLines[Idx], SubtitleFontSize));
+	}
+
+	int32 InputsWidth = 0;
+	for(auto const& Row : Inputs)
+	{
+		InputsWidth = FMath::Max(InputsWidth, GetRowWidth(Row));
+	}
+	int32 OutputsWidth = 0;
+	for(auto const& Row : Outputs)
+	{
+		OutputsWidth = FMath::Max(OutputsWidth, GetRowWidth(Row));
+	}
+
+	int32 const BodyWidth = InputsWidth + (InputsWidth > 0 && OutputsWidth > 0 ? ColumnGap : 0) + OutputsWidth;
+	int32 const Width = FMath::Max3(MinWidth, TitleWidth, BodyWidth) + Padding * 2;
+	int32 const TitleHeight = Padding + TitleLineHeight + (TitleLines.Num() - 1) * SubtitleLineHeight + Padding / 2;
+	int32 const NumRows = FMath::Max(Inputs.Num(), Outputs.Num());
+	int32 const Height = TitleHeight + NumRows * RowHeight + Padding;
+
+	// Emit
+	FString Svg;
+	Svg.Reserve(1024 + NumRows * 512);
+	Svg += FString::Printf(TEXT("<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\" viewBox=\"0 0 %d %d\" font-family=\"Roboto,Arial,sans-serif\" font-size=\"%d\">"),
+		Width, Height, Width, Height, FontSize);
+	Svg += FString::Printf(TEXT("<rect x=\"1\" y=\"1\" width=\"%d\" height=\"%d\" rx=\"%d\" fill=\"#1c1c1c\" stroke=\"#000\" stroke-width=\"2\"/>"),
+		Width - 2, Height - 2, CornerRadius);
+	// Title bar, rounded at the top only
+	Svg += FString::Printf(TEXT("<path d=\"M1 %dV%dq0 -%d %d -%dH%dq%d 0 %d %dV%dz\" fill=\"%s\"/>"),
+		TitleHeight, 1 + CornerRadius, CornerRadius, CornerRadius, CornerRadius, Width - 1 - CornerRadius,
+		CornerRadius, CornerRadius, CornerRadius, TitleHeight, *ToSvgColor(Node->GetNodeTitleColor()));
+
+	int32 TextY = Padding + FontSize;
+	AppendText(Svg, TitleLines[0], Padding, TextY, TEXT(" fill=\"#fff\" font-weight=\"bold\""));
+	for(int32 Idx = 1; Idx < TitleLines.Num(); ++Idx)
+	{
+		TextY += SubtitleLineHeight;
+		AppendText(Svg, TitleLines[Idx], Padding, TextY, TEXT(" fill=\"#ccc\" font-size=\"10\""));
+	}
+
+	for(int32 Idx = 0; Idx < Inputs.Num(); ++Idx)
+	{
+		auto const& Row = Inputs[Idx];
+		int32 const CY = TitleHeight + Idx * RowHeight + RowHeight / 2 + Padding / 2;
+		int32 X = Padding;
+		AppendPinIcon(Svg, Row, X + IconSize / 2, CY);
+		X += IconSize + IconGap;
+		if(!Row.Label.IsEmpty())
+		{
+			AppendText(Svg, Row.Label, X, CY + FontSize / 3, TEXT(" fill=\"#fff\""));
+			X += EstimateTextWidth(Row.Label) + IconGap;
+		}
+		if(!Row.DefaultValue.IsEmpty())
+		{
+			int32 const BoxWidth = EstimateTextWidth(Row.DefaultValue) + IconGap * 2;
+			Svg += FString::Printf(TEXT("<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" rx=\"2\" fill=\"#0a0a0a\" stroke=\"#444\"/>"),
+				X, CY - RowHeight / 2 + 3, BoxWidth, RowHeight - 6);
+			AppendText(Svg, Row.DefaultValue, X + IconGap, CY + FontSize / 3, TEXT(" fill=\"#ddd\""));
+		}
+	}
+
+	for(int32 Idx = 0; Idx < Outputs.Num(); ++Idx)
+	{
+		auto const& Row = Outputs[Idx];
+		int32 const CY = TitleHeight + Idx * RowHeight + RowHeight / 2 + Padding / 2;
+		int32 const IconX = Width - Padding - IconSize / 2;
+		AppendPinIcon(Svg, Row, IconX, CY);
+		if(!Row.Label.IsEmpty())
+		{
+			AppendText(Svg, Row.Label, IconX - IconSize / 2 - IconGap, CY + FontSize / 3, TEXT(" fill=\"#fff\" text-anchor=\"end\""));
+		}
+	}
+
+	Svg += TEXT("</svg>");
+
+	OutImage.ContentHash = CityHash64(reinterpret_cast< char const* >(*Svg), Svg.Len() * sizeof(TCHAR));
+	OutImage.Write = [Svg = MoveTemp(Svg)](FString const& Path)
+	{
+		KANTANDOCGEN_TRACE_SCOPE("SvgWrite");
+
+		return FFileHelper::SaveStringToFile(Svg, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	};
+
+	return true;
+}
+
+
@@ -0,0 +1,25 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "DocGenNodeImageBackend.h"
+
+
+/*
+Lays the node out from its title and pins, approximating the look of the graph editor, and emits it as svg.
+Needs no rendering at all, so runs entirely on the doc gen worker, with file writes going to the thread pool.
+Text metrics are estimated, since there's no font measurement available off the game thread.
+*/
+class FDocGenSvgImageBackend: public IDocGenNodeImageBackend
+{
+public:
+	virtual bool GT_Init(UEdGraph* Graph) override { return true; }
+	virtual bool RenderNode(UEdGraphNode* Node, FDocGenNodeImage& OutImage) override;
+	virtual const TCHAR* GetExtension() const override { return TEXT("svg"); }
+};
+
+
@@ -0,0 +1,110 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenWidgetImageBackend.h"
+#include "KantanDocGenLog.h"
+#include "KantanDocGenTrace.h"
+#include "ThreadingHelpers.h"
+#include "SGraphNode.h"
+#include "SGraphPanel.h"
+#include "NodeFactory.h"
+#include "Slate/WidgetRenderer.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "TextureResource.h"
+#include "Runtime/ImageWriteQueue/Public/ImageWriteTask.h"
+#include "IImageWrapperModule.h"
+#include "Hash/CityHash.h"
+
+
+bool FDocGenWidgetImageBackend::GT_Init(UEdGraph* Graph)
+{
+	// Image writes happen on pool threads, which can't load modules
+	FModuleManager::LoadModuleChecked< IImageWrapperModule >(TEXT("ImageWrapper"));
+
+	GraphPanel = SNew(SGraphPanel)
+		.GraphObj(Graph)
+		;
+	// We want full detail for rendering, passing a super-high zoom value will guarantee the highest LOD.
+	GraphPanel->RestoreViewSettings(FVector2D(0, 0), 10.0f);
+
+	return true;
+}
+
+bool FDocGenWidgetImageBackend::RenderNode(UEdGraphNode* Node, FDocGenNodeImage& OutImage)
+{
+	const FVector2D DrawSize(1024.0f, 1024.0f);
+
+	FIntRect Rect;
+
+	TUniquePtr<TImagePixelData<FColor>> PixelData;
+
+	bool const bSuccess = DocGenThreads::RunOnGameThreadRetVal([this, Node, DrawSize, &Rect, &PixelData]
+	{
+		auto NodeWidget = FNodeFactory::CreateNodeWidget(Node);
+		NodeWidget->SetOwner(GraphPanel.ToSharedRef());
+
+		const bool bUseGammaCorrection = false;
+		FWidgetRenderer Renderer(bUseGammaCorrection);
+		Renderer.SetIsPrepassNeeded(true);
+		UTextureRenderTarget2D* RenderTarget = nullptr;
+		{
+			KANTANDOCGEN_TRACE_SCOPE("WidgetRender");
+			RenderTarget = Renderer.DrawWidget(NodeWidget.ToSharedRef(), DrawSize);
+		}
+
+		auto Desired = NodeWidget->GetDesiredSize();
+	
+		FTextureRenderTargetResource* RTResource = RenderTarget->GameThread_GetRenderTargetResource();
+		Rect = FIntRect(0, 0, (int32)Desired.X, (int32)Desired.Y);
+		FReadSurfaceDataFlags ReadPixelFlags(RCM_UNorm);
+		ReadPixelFlags.SetLinearToGamma(true); // @TODO: is this gamma correction, or something else?
+
+		PixelData = MakeUnique<TImagePixelData<FColor>>(FIntPoint((int32)Desired.X, (int32)Desired.Y));
+		PixelData->Pixels.SetNumUninitialized(Desired.X * Desired.Y);
+
+		KANTANDOCGEN_TRACE_SCOPE("PixelReadback");
+		if(RTResource->ReadPixelsPtr(PixelData->Pixels.GetData(), ReadPixelFlags, Rect) == false)
+		{
+			UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to read pixels for node image."));
+			return false;
+		}
+
+		return true;
+	});
+
+	if(!bSuccess)
+	{
+		return false;
+	}
+
+	// Force opaque before hashing, so that the hash reflects what will actually be written
+	for(auto& Pixel : PixelData->Pixels)
+	{
+		Pixel.A = 255;
+	}
+
+	FIntPoint const Size = PixelData->GetSize();
+	uint64 const Seed = ((uint64)(uint32)Size.X << 32) | (uint32)Size.Y;
+	OutImage.ContentHash = CityHash64WithSeed(reinterpret_cast< char const* >(PixelData->Pixels.GetData()), PixelData->Pixels.Num() * PixelData->Pixels.GetTypeSize(), Seed);
+
+	TUniquePtr<FImageWriteTask> ImageTask = MakeUnique<FImageWriteTask>();
+	ImageTask->PixelData = MoveTemp(PixelData);
+	ImageTask->Format = EImageFormat::PNG;
+	ImageTask->CompressionQuality = (int32)EImageCompressionQuality::Default;
+	ImageTask->bOverwriteFile = true;
+
+	OutImage.Write = [ImageTask = MoveTemp(ImageTask)](FString const& Path) mutable
+	{
+		KANTANDOCGEN_TRACE_SCOPE("PngEncode");
+
+		ImageTask->Filename = Path;
+		return ImageTask->RunTask();
+	};
+
+	return true;
+}
+
+
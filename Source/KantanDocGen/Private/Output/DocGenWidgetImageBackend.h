@@ -0,0 +1,29 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "DocGenNodeImageBackend.h"
+
+
+class SGraphPanel;
+
+/*
+Renders the node's graph editor widget to a render target and encodes it as png, exactly as it appears in the editor.
+Needs Slate rendering and a game thread round trip for every node.
+*/
+class FDocGenWidgetImageBackend: public IDocGenNodeImageBackend
+{
+public:
+	virtual bool GT_Init(UEdGraph* Graph) override;
+	virtual bool RenderNode(UEdGraphNode* Node, FDocGenNodeImage& OutImage) override;
+	virtual const TCHAR* GetExtension() const override { return TEXT("png"); }
+
+protected:
+	TSharedPtr< SGraphPanel > GraphPanel;
+};
+
+
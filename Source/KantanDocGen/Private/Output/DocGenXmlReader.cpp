@@ -0,0 +1,236 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenXmlReader.h"
+#include "KantanDocGenLog.h"
+#include "Misc/FileHelper.h"
+
+
+FDocGenXmlElement const* FDocGenXmlElement::FindChild(TCHAR const* ChildName) const
+{
+	for(auto const& Child : Children)
+	{
+		if(Child.Name == ChildName)
+		{
+			return &Child;
+		}
+	}
+	return nullptr;
+}
+
+FString FDocGenXmlElement::GetChildText(TCHAR const* ChildName) const
+{
+	auto Child = FindChild(ChildName);
+	return Child ? Child->Text : FString();
+}
+
+
+namespace
+{
+	class FParser
+	{
+	public:
+		FParser(FString const& InXml):
+			Ptr(*InXml)
+		{}
+
+		bool ParseDocument(FDocGenXmlElement& OutRoot)
+		{
+			SkipMarkup();
+			if(*Ptr != TEXT('<'))
+			{
+				return false;
+			}
+			return ParseElement(OutRoot);
+		}
+
+	protected:
+		bool StartsWith(TCHAR const* Str) const
+		{
+			return FCString::Strncmp(Ptr, Str, FCString::Strlen(Str)) == 0;
+		}
+
+		bool SkipPast(TCHAR const* Terminator)
+		{
+			TCHAR const* Found = FCString::Strstr(Ptr, Terminator);
+			if(Found == nullptr)
+			{
+				return false;
+			}
+			Ptr = Found + FCString::Strlen(Terminator);
+			return true;
+		}
+
+		// Skips whitespace, declarations, processing instructions and comments
+		void SkipMarkup()
+		{
+			while(true)
+			{
+				while(FChar::IsWhitespace(*Ptr))
+				{
+					++Ptr;
+				}
+
+				if(StartsWith(TEXT("<?")))
+				{
+					SkipPast(TEXT("?>"));
+				}
+				else if(StartsWith(TEXT("<!--")))
+				{
+					SkipPast(TEXT("-->"));
+				}
+				else if(StartsWith(TEXT("<!")) && !StartsWith(TEXT("<![CDATA[")))
+				{
+					SkipPast(TEXT(">"));
+				}
+				else
+				{
+					return;
+				}
+			}
+		}
+
+		FString ParseName()
+		{
+			TCHAR const* Start = Ptr;
+			while(*Ptr && !FChar::IsWhitespace(*Ptr) && *Ptr != TEXT('>') && *Ptr != TEXT('/'))
+			{
+				++Ptr;
+			}
+			return FString((int32)(Ptr - Start), Start);
+		}
+
+		static FString DecodeEntities(FString const& Text)
+		{
+			if(!Text.Contains(TEXT("&")))
+			{
+				return Text;
+			}
+
+			return Text
+				.Replace(TEXT("&lt;"), TEXT("<"))
+				.Replace(TEXT("&gt;"), TEXT(">"))
+				.Replace(TEXT("&quot;"), TEXT("\""))
+				.Replace(TEXT("&apos;"), TEXT("'"))
+				.Replace(TEXT("&amp;"), TEXT("&"))
+				;
+		}
+
+		bool ParseElement(FDocGenXmlElement& OutElement)
+		{
+			check(*Ptr == TEXT('<'));
+			++Ptr;
+			OutElement.Name = ParseName();
+			if(OutElement.Name.IsEmpty())
+			{
+				return false;
+			}
+
+			// Skip over any attributes
+			while(*Ptr && *Ptr != TEXT('>'))
+			{
+				if(*Ptr == TEXT('/') && Ptr[1] == TEXT('>'))
+				{
+					Ptr += 2;
+					return true;
+				}
+				++Ptr;
+			}
+			if(*Ptr == 0)
+			{
+				return false;
+			}
+			++Ptr;
+
+			// Content
+			while(*Ptr)
+			{
+				if(StartsWith(TEXT("<![CDATA[")))
+				{
+					Ptr += 9;
+					TCHAR const* End = FCString::Strstr(Ptr, TEXT("]]>"));
+					if(End == nullptr)
+					{
+						return false;
+					}
+					OutElement.Text.AppendChars(Ptr, (int32)(End - Ptr));
+					Ptr = End + 3;
+				}
+				else if(StartsWith(TEXT("</")))
+				{
+					Ptr += 2;
+					if(ParseName() != OutElement.Name)
+					{
+						return false;
+					}
+					return SkipPast(TEXT(">"));
+				}
+				else if(StartsWith(TEXT("<?")) || StartsWith(TEXT("<!")))
+				{
+					SkipMarkup();
+				}
+				else if(*Ptr == TEXT('<'))
+				{
+					if(!ParseElement(OutElement.Children.AddDefaulted_GetRef()))
+					{
+						return false;
+					}
+				}
+				else
+				{
+					// Plain text, ignoring whitespace used for layout
+					TCHAR const* Start = Ptr;
+					while(*Ptr && *Ptr != TEXT('<'))
+					{
+						++Ptr;
+					}
+
+					FString Text((int32)(Ptr - Start), Start);
+					if(!Text.TrimStartAndEnd().IsEmpty())
+					{
+						OutElement.Text += DecodeEntities(Text);
+					}
+				}
+			}
+
+			// Unterminated element
+			return false;
+		}
+
+	protected:
+		TCHAR const* Ptr;
+	};
+}
+
+
+namespace DocGenXmlReader
+{
+	bool Parse(FString const& Xml, FDocGenXmlElement& OutRoot)
+	{
+		OutRoot = FDocGenXmlElement();
+		return FParser(Xml).ParseDocument(OutRoot);
+	}
+
+	bool LoadFile(FString const& Path, FDocGenXmlElement& OutRoot)
+	{
+		FString Xml;
+		if(!FFileHelper::LoadFileToString(Xml, *Path))
+		{
+			UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to read '%s'"), *Path);
+			return false;
+		}
+
+		if(!Parse(Xml, OutRoot))
+		{
+			UE_LOG(LogKantanDocGen, Warning, TEXT("Failed to parse '%s'"), *Path);
+			return false;
+		}
+
+		return true;
+	}
+}
+
+
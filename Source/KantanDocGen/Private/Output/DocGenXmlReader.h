@@ -0,0 +1,33 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+struct FDocGenXmlElement
+{
+	FString Name;
+	FString Text;	// Character data directly within this element, with CDATA sections unwrapped
+	TArray< FDocGenXmlElement > Children;
+
+	FDocGenXmlElement const* FindChild(TCHAR const* ChildName) const;
+	/** Empty if there is no such child */
+	FString GetChildText(TCHAR const* ChildName) const;
+};
+
+/*
+Reads back documents produced by FDocGenXmlWriter.
+Only supports what the intermediate docs use: elements, text and CDATA. Attributes, comments and processing instructions are skipped.
+*/
+namespace DocGenXmlReader
+{
+	bool Parse(FString const& Xml, FDocGenXmlElement& OutRoot);
+	bool LoadFile(FString const& Path, FDocGenXmlElement& OutRoot);
+}
+
+
@@ -0,0 +1,119 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#include "DocGenXmlWriter.h"
+#include "KantanDocGenTrace.h"
+#include "Misc/FileHelper.h"
+#include "Containers/StringConv.h"
+
+
+FDocGenXmlWriter::FDocGenXmlWriter():
+	BytesSaved(0)
+{}
+
+void FDocGenXmlWriter::BeginDocument(TCHAR const* RootName)
+{
+	Buffer.Reset();
+	OpenElements.Reset();
+
+	Append(TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"));
+	BeginElement(RootName);
+}
+
+void FDocGenXmlWriter::EndDocument()
+{
+	while(OpenElements.Num() > 0)
+	{
+		EndElement();
+	}
+}
+
+void FDocGenXmlWriter::BeginElement(TCHAR const* Name)
+{
+	Indent();
+	Append(TEXT("<"));
+	Append(Name);
+	Append(TEXT(">\n"));
+
+	OpenElements.Push(Name);
+}
+
+void FDocGenXmlWriter::EndElement()
+{
+	TCHAR const* Name = OpenElements.Pop(false);
+
+	Indent();
+	Append(TEXT("</"));
+	Append(Name);
+	Append(TEXT(">\n"));
+}
+
+void FDocGenXmlWriter::WriteElement(TCHAR const* Name, FString const& Content)
+{
+	Indent();
+	Append(TEXT("<"));
+	Append(Name);
+	Append(TEXT(">"));
+	AppendCDATA(Content);
+	Append(TEXT("</"));
+	Append(Name);
+	Append(TEXT(">\n"));
+}
+
+bool FDocGenXmlWriter::SaveToFile(FString const& Path)
+{
+	KANTANDOCGEN_TRACE_SCOPE("FileWrite");
+
+	if(!FFileHelper::SaveArrayToFile(Buffer, *Path))
+	{
+		return false;
+	}
+
+	BytesSaved += Buffer.Num();
+	return true;
+}
+
+void FDocGenXmlWriter::Indent()
+{
+	for(int32 Idx = 0; Idx < OpenElements.Num(); ++Idx)
+	{
+		Buffer.Add('\t');
+	}
+}
+
+void FDocGenXmlWriter::Append(TCHAR const* Str)
+{
+	Append(Str, FCString::Strlen(Str));
+}
+
+void FDocGenXmlWriter::Append(TCHAR const* Str, int32 Len)
+{
+	FTCHARToUTF8 Converted(Str, Len);
+	Buffer.Append(reinterpret_cast< uint8 const* >(Converted.Get()), Converted.Length());
+}
+
+void FDocGenXmlWriter::AppendCDATA(FString const& Content)
+{
+	// A CDATA section can't contain its own terminator, so split the section around any occurrence of it
+	static TCHAR const Terminator[] = TEXT("]]>");
+	static int32 const TerminatorLen = UE_ARRAY_COUNT(Terminator) - 1;
+
+	Append(TEXT("<![CDATA["));
+
+	TCHAR const* Start = *Content;
+	while(TCHAR const* Found = FCString::Strstr(Start, Terminator))
+	{
+		// Emit up to and including "]]", then close and reopen before the ">"
+		Append(Start, (int32)(Found - Start) + 2);
+		Append(TEXT("]]><![CDATA["));
+		Start = Found + 2;
+	}
+	Append(Start, Content.Len() - (int32)(Start - *Content));
+
+	Append(TEXT("]]>"));
+}
+
+
@@ -0,0 +1,51 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Copyright (C) 2016-2017 Cameron Angus. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/*
+Forward-only xml writer, emitting utf-8 directly into a buffer which is reused across documents.
+All text content is written as CDATA.
+*/
+class FDocGenXmlWriter
+{
+public:
+	FDocGenXmlWriter();
+
+public:
+	/** Starts a new document, discarding the contents of the previous one but keeping the buffer allocation. */
+	void BeginDocument(TCHAR const* RootName = TEXT("root"));
+	/** Closes any elements still open. */
+	void EndDocument();
+
+	void BeginElement(TCHAR const* Name);
+	void EndElement();
+
+	/** Writes <Name><![CDATA[Content]]></Name> */
+	void WriteElement(TCHAR const* Name, FString const& Content);
+
+	bool SaveToFile(FString const& Path);
+
+	TArray< uint8 > const& GetBuffer() const { return Buffer; }
+	/** Total bytes written to disk by this writer */
+	int64 GetBytesSaved() const { return BytesSaved; }
+
+protected:
+	void Indent();
+	void Append(TCHAR const* Str);
+	void Append(TCHAR const* Str, int32 Len);
+	void AppendCDATA(FString const& Content);
+
+protected:
+	TArray< uint8 > Buffer;
+	TArray< TCHAR const* > OpenElements;
+	int64 BytesSaved;
+};
+
+
@@ -6,35 +6,73 @@
 
 #pragma once
 
-#include "Async/TaskGraphInterfaces.h"
+#include "GameThreadScheduler.h"
+#include "Async/Future.h"
 
 
 namespace DocGenThreads
 {
 
+	namespace Detail
+	{
+		template < typename TResult, typename TLambda >
+		inline void Fulfil(TPromise< TResult >& Promise, TLambda& Func)
+		{
+			Promise.SetValue(Func());
+		}
+
+		template < typename TLambda >
+		inline void Fulfil(TPromise< void >& Promise, TLambda& Func)
+		{
+			Func();
+			Promise.SetValue();
+		}
+	}
+
+	/*
+	Queues Func to run on the game thread within the scheduler's per-frame budget.
+	Returns immediately; the result is delivered through the returned future.
+	*/
+	template < typename TLambda >
+	inline auto EnqueueOnGameThread(TLambda Func) -> TFuture< decltype(Func()) >
+	{
+		typedef decltype(Func()) TResult;
+
+		TSharedRef< TPromise< TResult >, ESPMode::ThreadSafe > Promise = MakeShared< TPromise< TResult >, ESPMode::ThreadSafe >();
+		TFuture< TResult > Future = Promise->GetFuture();
+
+		FDocGenGameThreadScheduler::Get().Enqueue([Promise, Func = MoveTemp(Func)]() mutable
+		{
+			Detail::Fulfil(*Promise, Func);
+		});
+
+		return Future;
+	}
+
 	template < typename TLambda >
 	inline auto RunOnGameThread(TLambda Func) -> void
 	{
-		FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady(MoveTemp(Func), TStatId(), nullptr, ENamedThreads::GameThread);
-		FTaskGraphInterface::Get().WaitUntilTaskCompletes(Task);
+		if(IsInGameThread())
+		{
+			Func();
+			return;
+		}
+
+		EnqueueOnGameThread(MoveTemp(Func)).Wait();
 	}
 
 	template < typename TLambda, typename... TArgs >
 	inline auto RunOnGameThreadRetVal(TLambda Func, TArgs&... Args) -> decltype(Func(Args...))
 	{
-		typedef decltype(Func(Args...)) TResult;
-
-		TResult Result;
-		TFunction<void()> NullaryFunc = [&]
+		if(IsInGameThread())
 		{
-			Result = Func(Args...);
-		};
-
-		FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady(NullaryFunc, TStatId(), nullptr, ENamedThreads::GameThread);
-		FTaskGraphInterface::Get().WaitUntilTaskCompletes(Task);
+			return Func(Args...);
+		}
 
-		return Result;
+		return EnqueueOnGameThread([&]
+		{
+			return Func(Args...);
+		}).Get();
 	}
 
 }
-